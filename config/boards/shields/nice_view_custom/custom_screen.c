@@ -6,6 +6,14 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+#include "widgets/panel_flush.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+#include "widgets/flush_async.h"
+#endif
+#include "widgets/latency.h"
+
 #if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
 #include "widgets/custom_status.h"
 static struct zmk_widget_custom_status status_widget;
@@ -17,6 +25,14 @@ static struct zmk_widget_peripheral_status status_widget;
 lv_obj_t *zmk_display_status_screen() {
     lv_obj_t *screen = lv_obj_create(NULL);
 
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+    panel_flush_init();
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+    flush_async_init();
+#endif
+    latency_init();
+
 #if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
     zmk_widget_custom_status_init(&status_widget, screen);
     lv_obj_align(zmk_widget_custom_status_obj(&status_widget), LV_ALIGN_TOP_LEFT, 0, 0);
@@ -0,0 +1,17 @@
+/*
+ * Custom Nice!View host render benchmark
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "host.h"
+
+// The widget's last init stage runs the benchmark (see run_bench in
+// widgets/custom_status.c and widgets/peripheral_status.c), which logs one
+// "nvbench" JSON line per case to stdout for scripts/bench_report.py
+int main(void) {
+    host_display_init(0);
+    host_screen_start();
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Custom Nice!View host harness: LVGL display and allocator
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "host.h"
+#include "lvgl_mem.h"
+
+#define PANEL_WIDTH 160
+#define PANEL_HEIGHT 68
+#define PANEL_STRIDE (PANEL_WIDTH / 8)
+// ZMK's display thread runs the LVGL timer handler this often
+#define DISPLAY_TICK_MS 10
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_color_t vdb[PANEL_WIDTH * PANEL_HEIGHT];
+static lv_disp_drv_t disp_drv;
+// 1 = foreground, MSB first
+static uint8_t pixels[PANEL_STRIDE * PANEL_HEIGHT];
+static uint32_t flush_ns;
+static struct host_display_stats stats;
+
+void *lvgl_malloc(size_t size) { return malloc(size); }
+
+void *lvgl_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+
+void lvgl_free(void *ptr) { free(ptr); }
+
+static void host_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    lv_color_t fg = lv_color_black();
+
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        for (lv_coord_t x = area->x1; x <= area->x2; x++) {
+            uint8_t *byte = &pixels[y * PANEL_STRIDE + x / 8];
+            uint8_t bit = 0x80 >> (x % 8);
+            *byte = color_p->full == fg.full ? *byte | bit : *byte & ~bit;
+            color_p++;
+        }
+    }
+    stats.flushes++;
+    stats.flushed_px += lv_area_get_size(area);
+
+    // The panel transfer blocks the display queue for this long
+    host_clock_skip_to(host_clock_ns() + flush_ns);
+    lv_disp_flush_ready(drv);
+}
+
+static void display_tick_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(display_tick, display_tick_cb);
+
+static void display_tick_cb(struct k_work *work) {
+    lv_timer_handler();
+    k_work_schedule_for_queue(zmk_display_work_q(), &display_tick, K_MSEC(DISPLAY_TICK_MS));
+}
+
+void host_display_init(uint32_t flush_us) {
+    flush_ns = flush_us * NSEC_PER_USEC;
+
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, vdb, NULL, ARRAY_SIZE(vdb));
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = PANEL_WIDTH;
+    disp_drv.ver_res = PANEL_HEIGHT;
+    disp_drv.flush_cb = host_flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    k_work_schedule_for_queue(zmk_display_work_q(), &display_tick, K_MSEC(DISPLAY_TICK_MS));
+}
+
+const uint8_t *host_display_pixels(void) { return pixels; }
+
+void host_display_get_stats(struct host_display_stats *out) { *out = stats; }
+
+void host_screen_start(void) {
+    lv_obj_t *screen = zmk_display_status_screen();
+
+    lv_scr_load(screen);
+    // The first init stage ran inside zmk_display_status_screen, the rest
+    // are queued one after another
+    host_queue_drain();
+    lv_refr_now(NULL);
+}
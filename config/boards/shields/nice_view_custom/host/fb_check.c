@@ -0,0 +1,184 @@
+/*
+ * Custom Nice!View direct framebuffer check
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "fb.h"
+#include "nv_assets.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Each case draws into this many random views, with random contents
+#define CHECK_ITERATIONS 200000
+// Wide enough for the single canvas screen, whose views are windows of it
+#define CHECK_MAX_STRIDE (FB_STRIDE + 12)
+#define CHECK_BUF_SIZE (CHECK_MAX_STRIDE * CANVAS_SIZE)
+// Only the first few mismatches of a case are logged
+#define CHECK_LOG_MAX 4
+
+static uint8_t fast[CHECK_BUF_SIZE];
+static uint8_t ref[CHECK_BUF_SIZE];
+static uint8_t src[FB_SIZE];
+
+// xorshift32, so a failing case reproduces on every libc
+static uint32_t rng_state = 0x2545f491;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static int rng_range(int lo, int hi) { return lo + (int)(rng() % (uint32_t)(hi - lo + 1)); }
+
+static void fill_random(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = rng();
+    }
+}
+
+// A view of random stride, offset and row window, the two buffers holding
+// the same random pixels
+static struct fb_view random_view(void) {
+    struct fb_view view = {.buf = fast};
+
+    view.stride = rng_range(FB_STRIDE, CHECK_MAX_STRIDE);
+    view.col0 = rng_range(0, view.stride * 8 - CANVAS_SIZE);
+    view.y0 = rng_range(0, CANVAS_SIZE - 1);
+    view.y1 = rng_range(view.y0 + 1, CANVAS_SIZE);
+    fill_random(fast, view.stride * CANVAS_SIZE);
+    memcpy(ref, fast, view.stride * CANVAS_SIZE);
+    return view;
+}
+
+static struct fb_view ref_view(const struct fb_view *view) {
+    struct fb_view out = *view;
+    out.buf = ref;
+    return out;
+}
+
+// One pixel at a time, straight from the mapping in util.h
+static bool ref_get(const struct fb_view *view, lv_coord_t x, lv_coord_t y) {
+    int col = view->col0 + CANVAS_SIZE - 1 - y;
+    return view->buf[x * view->stride + col / 8] & (0x80 >> (col % 8));
+}
+
+static void ref_set(const struct fb_view *view, lv_coord_t x, lv_coord_t y, bool ink) {
+    if (x < 0 || x >= CANVAS_SIZE || y < view->y0 || y >= view->y1) {
+        return;
+    }
+    int col = view->col0 + CANVAS_SIZE - 1 - y;
+    uint8_t *byte = &view->buf[x * view->stride + col / 8];
+    uint8_t mask = 0x80 >> (col % 8);
+    *byte = ink ? *byte | mask : *byte & ~mask;
+}
+
+static bool same(const struct fb_view *view) {
+    return memcmp(fast, ref, view->stride * CANVAS_SIZE) == 0;
+}
+
+static void log_mismatch(const char *name, uint32_t *bad, const struct fb_view *view,
+                         lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h) {
+    if (++*bad <= CHECK_LOG_MAX) {
+        LOG_ERR("%s differs at x %d y %d w %d h %d, view stride %u col0 %d rows %d..%d", name, x,
+                y, w, h, view->stride, view->col0, view->y0, view->y1);
+    }
+}
+
+// The same sprite drawn from its region-layout rows and from its image
+static uint32_t check_blit(void) {
+    uint32_t bad = 0;
+
+    for (int i = 0; i < CHECK_ITERATIONS; i++) {
+        struct fb_view view = random_view();
+        struct fb_view other = ref_view(&view);
+        lv_coord_t x = rng_range(-bolt.header.w, CANVAS_SIZE);
+        lv_coord_t y = rng_range(-bolt.header.h, CANVAS_SIZE);
+
+        fb_blit(&view, x, y, &bolt_sprite);
+        fb_draw_img(&other, x, y, &bolt);
+        if (!same(&view)) {
+            log_mismatch("fb_blit", &bad, &view, x, y, bolt.header.w, bolt.header.h);
+        }
+    }
+    return bad;
+}
+
+static uint32_t check_fill_rect(void) {
+    uint32_t bad = 0;
+
+    for (int i = 0; i < CHECK_ITERATIONS; i++) {
+        struct fb_view view = random_view();
+        struct fb_view other = ref_view(&view);
+        lv_coord_t x = rng_range(-16, CANVAS_SIZE + 4);
+        lv_coord_t y = rng_range(-16, CANVAS_SIZE + 4);
+        lv_coord_t w = rng_range(0, 40);
+        lv_coord_t h = rng_range(0, 40);
+        bool ink = rng() & 1;
+
+        fb_fill_rect(&view, x, y, w, h, ink);
+        for (lv_coord_t px = x; px < x + w; px++) {
+            for (lv_coord_t py = y; py < y + h; py++) {
+                ref_set(&other, px, py, ink);
+            }
+        }
+        if (!same(&view)) {
+            log_mismatch("fb_fill_rect", &bad, &view, x, y, w, h);
+        }
+    }
+    return bad;
+}
+
+// From a plain region view, as the graph scroll reads it
+static uint32_t check_copy_rect(void) {
+    struct fb_view from = fb_view_region(src);
+    uint32_t bad = 0;
+
+    for (int i = 0; i < CHECK_ITERATIONS; i++) {
+        struct fb_view view = random_view();
+        struct fb_view other = ref_view(&view);
+        lv_coord_t x = rng_range(-16, CANVAS_SIZE + 4);
+        lv_coord_t y = rng_range(-16, CANVAS_SIZE + 4);
+        lv_coord_t w = rng_range(0, CANVAS_SIZE + 2);
+        lv_coord_t h = rng_range(0, CANVAS_SIZE + 2);
+
+        fill_random(src, sizeof(src));
+        fb_copy_rect(&view, &from, x, y, w, h);
+        for (lv_coord_t px = MAX(x, 0); px < MIN(x + w, CANVAS_SIZE); px++) {
+            for (lv_coord_t py = MAX(y, 0); py < MIN(y + h, CANVAS_SIZE); py++) {
+                ref_set(&other, px, py, ref_get(&from, px, py));
+            }
+        }
+        if (!same(&view)) {
+            log_mismatch("fb_copy_rect", &bad, &view, x, y, w, h);
+        }
+    }
+    return bad;
+}
+
+// Exits nonzero when any fast path disagrees with its reference
+int main(void) {
+    static const struct {
+        const char *name;
+        uint32_t (*run)(void);
+    } cases[] = {
+        {"fb_blit", check_blit},
+        {"fb_fill_rect", check_fill_rect},
+        {"fb_copy_rect", check_copy_rect},
+    };
+    int failed = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(cases); i++) {
+        uint32_t bad = cases[i].run();
+        LOG_INF("%s: %u of %u draws differ", cases[i].name, bad, CHECK_ITERATIONS);
+        failed |= bad != 0;
+    }
+    return failed;
+}
@@ -0,0 +1,72 @@
+/*
+ * Custom Nice!View host harness
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <zmk/activity.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid.h>
+#include <zmk/keymap.h>
+
+// Clock: host_clock_ns (see zephyr/kernel.h) runs in real time, and jumps
+// ahead whenever the queue runner would otherwise wait
+void host_clock_skip_to(uint64_t ns);
+
+// Run queued work items, and timers as they come due, until the clock
+// reaches `until_ns`. Stretches with nothing to run are skipped, not slept.
+void host_queue_run_until(uint64_t until_ns);
+static inline void host_queue_run_for(uint32_t ms) {
+    host_queue_run_until(host_clock_ns() + (uint64_t)ms * NSEC_PER_MSEC);
+}
+// Run everything queued right now, and what that queues in turn, without
+// advancing the clock for timers
+void host_queue_drain(void);
+
+// State behind the stubbed ZMK getters. Set it, then raise the matching
+// event, the way the firmware updates its state before notifying.
+struct host_zmk {
+    uint8_t battery;
+    bool usb_powered;
+    enum zmk_activity_state activity;
+    int wpm;
+    zmk_mod_flags_t explicit_mods;
+    uint32_t layer_state;
+    // Keymap order: index -> layer id, and each id's display name
+    zmk_keymap_layer_id_t layer_ids[ZMK_KEYMAP_LAYERS_LEN];
+    const char *layer_names[ZMK_KEYMAP_LAYERS_LEN];
+    struct zmk_endpoint_instance endpoint;
+    int ble_profile;
+    bool ble_connected;
+    bool ble_open;
+    bool split_connected;
+};
+
+extern struct host_zmk host_zmk;
+
+// A 160x68 LVGL display, refreshed from the host queue every LVGL tick like
+// ZMK's display thread. Flushes land in a packed 1bpp copy of the panel and
+// take flush_us of (skipped) clock time, to stand in for the SPI transfer.
+struct host_display_stats {
+    uint32_t flushes;
+    uint32_t flushed_px;
+};
+
+void host_display_init(uint32_t flush_us);
+const uint8_t *host_display_pixels(void);
+void host_display_get_stats(struct host_display_stats *stats);
+
+// custom_screen.c
+lv_obj_t *zmk_display_status_screen(void);
+
+// Build the status screen through the real zmk_display_status_screen and
+// run the widget's init stages
+void host_screen_start(void);
+
+// Debug lines print from level 4 on
+extern int host_log_level;
@@ -0,0 +1,58 @@
+/*
+ * Kconfig values for the host build, force-included into every widget
+ * source. Defaults follow Kconfig.defconfig; CMakeLists.txt turns the
+ * optional features on per executable with -DCONFIG_...=1.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/sys/util.h>
+
+#define CONFIG_ZMK_LOG_LEVEL 3
+#define CONFIG_APPLICATION_INIT_PRIORITY 90
+#define CONFIG_LV_COLOR_DEPTH_1 1
+#define CONFIG_LV_Z_MEM_POOL_SIZE 4096
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET 1
+
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_MAX_FPS
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_MAX_FPS 20
+#endif
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_HISTORY
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_HISTORY 64
+#endif
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_SCRATCH_SIZE
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_SCRATCH_SIZE 512
+#endif
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE_SIZE
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE_SIZE 1024
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR) &&                                  \
+    !defined(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_REFRESH_SEC)
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_REFRESH_SEC 60
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_PRIORITY
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_PRIORITY 10
+#endif
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_STACK_SIZE
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_STACK_SIZE 1536
+#endif
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES 200
+#endif
+#ifndef CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_REFRESH_FRAMES
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_REFRESH_FRAMES 20
+#endif
+#endif
+
+// The periodic log would keep the host queue busy forever; the harness
+// dumps the histograms once at the end instead
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+#define CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY_LOG_INTERVAL 0
+#endif
@@ -0,0 +1,13 @@
+/*
+ * Host stand-in for Zephyr's LVGL allocator, which lv_conf.h points LVGL at.
+ * widgets/lvgl_pool.c wraps these at link time, as on the device.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+void *lvgl_malloc(size_t size);
+void *lvgl_realloc(void *ptr, size_t size);
+void lvgl_free(void *ptr);
@@ -0,0 +1,129 @@
+/*
+ * Host stand-in for the parts of <zephyr/kernel.h> the widgets use
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+// Time. The host clock is the real monotonic clock plus every stretch the
+// work queue runner skipped while it had nothing to run (see host.h), so
+// render work is timed for real and idle waits cost nothing. One cycle is
+// one nanosecond.
+
+#define MSEC_PER_SEC 1000
+#define USEC_PER_MSEC 1000
+#define USEC_PER_SEC 1000000
+#define NSEC_PER_USEC 1000
+#define NSEC_PER_MSEC 1000000
+#define NSEC_PER_SEC 1000000000
+
+uint64_t host_clock_ns(void);
+
+static inline int64_t k_uptime_get(void) { return (int64_t)(host_clock_ns() / NSEC_PER_MSEC); }
+static inline uint32_t k_uptime_get_32(void) { return (uint32_t)k_uptime_get(); }
+static inline uint32_t k_cycle_get_32(void) { return (uint32_t)host_clock_ns(); }
+static inline uint32_t sys_clock_hw_cycles_per_sec(void) { return NSEC_PER_SEC; }
+static inline uint64_t k_cyc_to_ns_floor64(uint64_t cyc) { return cyc; }
+static inline uint32_t k_cyc_to_us_floor32(uint64_t cyc) { return (uint32_t)(cyc / NSEC_PER_USEC); }
+static inline uint64_t k_cyc_to_us_floor64(uint64_t cyc) { return cyc / NSEC_PER_USEC; }
+
+typedef struct {
+    // Negative waits forever
+    int64_t ns;
+} k_timeout_t;
+
+#define K_NO_WAIT ((k_timeout_t){.ns = 0})
+#define K_FOREVER ((k_timeout_t){.ns = -1})
+#define K_USEC(us) ((k_timeout_t){.ns = (int64_t)(us) * NSEC_PER_USEC})
+#define K_MSEC(ms) ((k_timeout_t){.ns = (int64_t)(ms) * NSEC_PER_MSEC})
+#define K_SECONDS(s) K_MSEC((int64_t)(s) * MSEC_PER_SEC)
+
+// Work items. There is one host work queue, drained by the harness; it
+// stands in for the display queue and the system queue alike. Submitting an
+// item that is already queued does nothing, as on Zephyr.
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+    struct k_work *next;
+    k_work_handler_t handler;
+    bool queued;
+    bool running;
+};
+
+struct k_work_delayable {
+    struct k_work work;
+    struct k_work_delayable *next_timer;
+    uint64_t deadline_ns;
+    bool scheduled;
+};
+
+struct k_work_q {
+    const char *name;
+};
+
+#define K_WORK_DEFINE(name, work_handler) struct k_work name = {.handler = work_handler}
+#define K_WORK_DELAYABLE_DEFINE(name, work_handler)                                               \
+    struct k_work_delayable name = {.work = {.handler = work_handler}}
+
+extern struct k_work_q k_sys_work_q;
+
+void k_work_init(struct k_work *work, k_work_handler_t handler);
+int k_work_submit_to_queue(struct k_work_q *queue, struct k_work *work);
+int k_work_submit(struct k_work *work);
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler);
+int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+                              k_timeout_t delay);
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+                                k_timeout_t delay);
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_cancel_delayable(struct k_work_delayable *dwork);
+bool k_work_delayable_is_pending(const struct k_work_delayable *dwork);
+
+static inline struct k_work_delayable *k_work_delayable_from_work(struct k_work *work) {
+    return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+// Threads. A started queue gets no thread of its own: its items go on the
+// one host queue and run in order with everything else, so the stack is
+// never used.
+
+#define K_THREAD_STACK_DEFINE(sym, size) char sym[size]
+#define K_THREAD_STACK_SIZEOF(sym) sizeof(sym)
+
+struct k_work_queue_config {
+    const char *name;
+    bool no_yield;
+};
+
+void k_work_queue_start(struct k_work_q *queue, char *stack, size_t stack_size, int prio,
+                        const struct k_work_queue_config *config);
+
+// Asserts are always on in the host build
+#define __ASSERT(cond, fmt, ...)                                                                  \
+    do {                                                                                          \
+        if (!(cond)) {                                                                            \
+            fprintf(stderr, "%s:%d: assertion \"%s\" failed: " fmt "\n", __FILE__, __LINE__,     \
+                    #cond, ##__VA_ARGS__);                                                        \
+            abort();                                                                              \
+        }                                                                                         \
+    } while (0)
+#define __ASSERT_NO_MSG(cond) __ASSERT(cond, "")
+
+// Init hooks run before main
+#define SYS_INIT(init_fn, level, prio)                                                            \
+    static void __attribute__((constructor)) sys_init_##init_fn(void) { (void)init_fn(); }
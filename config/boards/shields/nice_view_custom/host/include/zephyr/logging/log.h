@@ -0,0 +1,25 @@
+/*
+ * Host stand-in for <zephyr/logging/log.h>: every level goes to stdout in
+ * Zephyr's "<lvl> module: message" shape, so scripts that parse device logs
+ * read host logs too
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+// Debug lines only print when the harness raises host_log_level to 4
+#define LOG_MODULE_DECLARE(name, level) extern int host_log_level
+
+#define HOST_LOG(lvl, fmt, ...) printf("<" lvl "> zmk: " fmt "\n", ##__VA_ARGS__)
+
+#define LOG_ERR(fmt, ...) HOST_LOG("err", fmt, ##__VA_ARGS__)
+#define LOG_WRN(fmt, ...) HOST_LOG("wrn", fmt, ##__VA_ARGS__)
+#define LOG_INF(fmt, ...) HOST_LOG("inf", fmt, ##__VA_ARGS__)
+#define LOG_DBG(fmt, ...)                                                                         \
+    do {                                                                                          \
+        if (host_log_level >= 4) {                                                                \
+            HOST_LOG("dbg", fmt, ##__VA_ARGS__);                                                  \
+        }                                                                                         \
+    } while (0)
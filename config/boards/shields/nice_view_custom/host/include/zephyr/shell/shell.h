@@ -0,0 +1,9 @@
+/*
+ * Host stand-in for <zephyr/shell/shell.h>. The host build has no shell;
+ * statistics are dumped to the log instead.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+struct shell;
@@ -0,0 +1,49 @@
+/*
+ * Host stand-in for <zephyr/sys/atomic.h>, on the compiler's builtins
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+typedef long atomic_t;
+typedef long atomic_val_t;
+
+#define ATOMIC_BITS (sizeof(atomic_val_t) * 8)
+#define ATOMIC_BITMAP_SIZE(num_bits) (((num_bits) + ATOMIC_BITS - 1) / ATOMIC_BITS)
+#define ATOMIC_DEFINE(name, num_bits) atomic_t name[ATOMIC_BITMAP_SIZE(num_bits)]
+
+static inline atomic_val_t atomic_get(const atomic_t *target) {
+    return __atomic_load_n(target, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value) {
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_clear(atomic_t *target) { return atomic_set(target, 0); }
+
+// Both return the previous value
+static inline atomic_val_t atomic_inc(atomic_t *target) {
+    return __atomic_fetch_add(target, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline atomic_val_t atomic_dec(atomic_t *target) {
+    return __atomic_fetch_sub(target, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline bool atomic_cas(atomic_t *target, atomic_val_t old_value, atomic_val_t new_value) {
+    return __atomic_compare_exchange_n(target, &old_value, new_value, false, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST);
+}
+
+static inline bool atomic_test_and_set_bit(atomic_t *target, int bit) {
+    atomic_val_t mask = 1L << (bit % ATOMIC_BITS);
+    return (__atomic_fetch_or(&target[bit / ATOMIC_BITS], mask, __ATOMIC_SEQ_CST) & mask) != 0;
+}
+
+static inline bool atomic_test_and_clear_bit(atomic_t *target, int bit) {
+    atomic_val_t mask = 1L << (bit % ATOMIC_BITS);
+    return (__atomic_fetch_and(&target[bit / ATOMIC_BITS], ~mask, __ATOMIC_SEQ_CST) & mask) != 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Host stand-in for <zephyr/sys/slist.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+typedef struct _snode {
+    struct _snode *next;
+} sys_snode_t;
+
+typedef struct {
+    sys_snode_t *head;
+    sys_snode_t *tail;
+} sys_slist_t;
+
+#define SYS_SLIST_STATIC_INIT(ptr_to_list) {NULL, NULL}
+
+static inline void sys_slist_append(sys_slist_t *list, sys_snode_t *node) {
+    node->next = NULL;
+    if (list->tail == NULL) {
+        list->head = node;
+    } else {
+        list->tail->next = node;
+    }
+    list->tail = node;
+}
+
+#define SYS_SLIST_CONTAINER(node, var, field)                                                     \
+    ((node) == NULL ? NULL : CONTAINER_OF(node, __typeof__(*(var)), field))
+
+#define SYS_SLIST_FOR_EACH_CONTAINER(list, var, field)                                            \
+    for (var = SYS_SLIST_CONTAINER((list)->head, var, field); var != NULL;                       \
+         var = SYS_SLIST_CONTAINER((var)->field.next, var, field))
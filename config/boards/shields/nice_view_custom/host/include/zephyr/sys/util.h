@@ -0,0 +1,37 @@
+/*
+ * Host stand-in for the parts of <zephyr/sys/util.h> the widgets use
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// IS_ENABLED(CONFIG_X) is 1 when CONFIG_X is defined to 1 and 0 otherwise,
+// usable in #if like Zephyr's
+#define Z_IS_ENABLED_PROBE_1 Z_IS_ENABLED_ARG,
+#define Z_IS_ENABLED_TAKE(ignore, val, ...) val
+#define Z_IS_ENABLED_EXPAND(one_or_two) Z_IS_ENABLED_TAKE(one_or_two 1, 0, 0)
+#define Z_IS_ENABLED_PASTE(config) Z_IS_ENABLED_EXPAND(Z_IS_ENABLED_PROBE_##config)
+#define IS_ENABLED(config) Z_IS_ENABLED_PASTE(config)
+
+#define BIT(n) (1UL << (n))
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define ARG_UNUSED(x) (void)(x)
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#define CLAMP(val, low, high) (((val) <= (low)) ? (low) : MIN(val, high))
+#define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
+#define ROUND_UP(x, align) (DIV_ROUND_UP(x, align) * (align))
+
+#define __aligned(x) __attribute__((__aligned__(x)))
+#define __used __attribute__((__used__))
+#define __unused __attribute__((__unused__))
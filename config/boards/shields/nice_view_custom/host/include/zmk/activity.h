@@ -0,0 +1,14 @@
+/*
+ * Host stand-in for <zmk/activity.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+enum zmk_activity_state {
+    ZMK_ACTIVITY_ACTIVE,
+    ZMK_ACTIVITY_IDLE,
+    ZMK_ACTIVITY_SLEEP,
+};
+
+enum zmk_activity_state zmk_activity_get_state(void);
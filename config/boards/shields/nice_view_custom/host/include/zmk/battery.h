@@ -0,0 +1,10 @@
+/*
+ * Host stand-in for <zmk/battery.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+uint8_t zmk_battery_state_of_charge(void);
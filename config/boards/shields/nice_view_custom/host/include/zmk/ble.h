@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for <zmk/ble.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+int zmk_ble_active_profile_index(void);
+bool zmk_ble_active_profile_is_connected(void);
+bool zmk_ble_active_profile_is_open(void);
@@ -0,0 +1,29 @@
+/*
+ * Host stand-in for <zmk/display.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+struct k_work_q *zmk_display_work_q(void);
+
+// Same shape as ZMK's: the event side stores the state and submits the
+// listener's work item, which hands the state to cb on the display queue.
+// The host is single-threaded, so there is no mutex.
+#define ZMK_DISPLAY_WIDGET_LISTENER(listener, state_type, cb, state_func)                         \
+    static state_type __##listener##_state;                                                       \
+    static void listener##_refresh(struct k_work *work) { cb(__##listener##_state); }             \
+    static K_WORK_DEFINE(listener##_work, listener##_refresh);                                    \
+    static void listener##_init(void) {                                                           \
+        __##listener##_state = state_func(NULL);                                                  \
+        cb(__##listener##_state);                                                                 \
+    }                                                                                             \
+    static int listener##_cb(const zmk_event_t *eh) {                                             \
+        __##listener##_state = state_func(eh);                                                    \
+        k_work_submit_to_queue(zmk_display_work_q(), &listener##_work);                           \
+        return ZMK_EV_EVENT_BUBBLE;                                                               \
+    }                                                                                             \
+    ZMK_LISTENER(listener, listener##_cb)
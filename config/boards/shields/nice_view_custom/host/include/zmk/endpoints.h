@@ -0,0 +1,26 @@
+/*
+ * Host stand-in for <zmk/endpoints.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum zmk_transport {
+    ZMK_TRANSPORT_USB,
+    ZMK_TRANSPORT_BLE,
+};
+
+struct zmk_endpoint_instance {
+    enum zmk_transport transport;
+    union {
+        struct {
+            uint8_t profile_index;
+        } ble;
+    };
+};
+
+struct zmk_endpoint_instance zmk_endpoints_selected(void);
+bool zmk_endpoint_instance_eq(struct zmk_endpoint_instance a, struct zmk_endpoint_instance b);
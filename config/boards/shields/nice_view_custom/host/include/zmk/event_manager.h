@@ -0,0 +1,54 @@
+/*
+ * Host stand-in for <zmk/event_manager.h>. Events are delivered to their
+ * subscribers synchronously on the raising thread, in registration order.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct zmk_event_type {
+    const char *name;
+};
+
+typedef struct {
+    const struct zmk_event_type *event;
+} zmk_event_t;
+
+struct zmk_listener {
+    int (*callback)(const zmk_event_t *eh);
+};
+
+#define ZMK_EV_EVENT_BUBBLE 0
+
+void host_event_subscribe(const struct zmk_event_type *type, const struct zmk_listener *listener);
+int host_event_raise(const zmk_event_t *event);
+
+#define ZMK_EVENT_DECLARE(event_type)                                                             \
+    struct event_type##_event {                                                                   \
+        zmk_event_t header;                                                                       \
+        struct event_type data;                                                                   \
+    };                                                                                            \
+    extern const struct zmk_event_type zmk_event_##event_type;                                    \
+    static inline struct event_type *as_##event_type(const zmk_event_t *eh) {                     \
+        return eh->event == &zmk_event_##event_type ? &((struct event_type##_event *)eh)->data    \
+                                                    : NULL;                                       \
+    }                                                                                             \
+    static inline int raise_##event_type(struct event_type data) {                                \
+        struct event_type##_event ev = {.header = {.event = &zmk_event_##event_type},             \
+                                        .data = data};                                            \
+        return host_event_raise(&ev.header);                                                      \
+    }
+
+#define ZMK_EVENT_IMPL(event_type)                                                                \
+    const struct zmk_event_type zmk_event_##event_type = {.name = #event_type}
+
+#define ZMK_LISTENER(mod, cb) const struct zmk_listener zmk_listener_##mod = {.callback = cb};
+
+// Subscriptions register from a constructor instead of a linker section
+#define ZMK_SUBSCRIPTION(mod, ev_type)                                                            \
+    static void __attribute__((constructor)) host_subscribe_##mod##_##ev_type(void) {             \
+        host_event_subscribe(&zmk_event_##ev_type, &zmk_listener_##mod);                          \
+    }                                                                                             \
+    extern const struct zmk_listener zmk_listener_##mod
@@ -0,0 +1,15 @@
+/*
+ * Host stand-in for <zmk/events/activity_state_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/activity.h>
+#include <zmk/event_manager.h>
+
+struct zmk_activity_state_changed {
+    enum zmk_activity_state state;
+};
+
+ZMK_EVENT_DECLARE(zmk_activity_state_changed);
@@ -0,0 +1,15 @@
+/*
+ * Host stand-in for <zmk/events/ble_active_profile_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zmk/event_manager.h>
+
+struct zmk_ble_active_profile_changed {
+    uint8_t index;
+};
+
+ZMK_EVENT_DECLARE(zmk_ble_active_profile_changed);
@@ -0,0 +1,15 @@
+/*
+ * Host stand-in for <zmk/events/endpoint_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+
+struct zmk_endpoint_changed {
+    struct zmk_endpoint_instance endpoint;
+};
+
+ZMK_EVENT_DECLARE(zmk_endpoint_changed);
@@ -0,0 +1,15 @@
+/*
+ * Host stand-in for <zmk/events/split_peripheral_status_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <zmk/event_manager.h>
+
+struct zmk_split_peripheral_status_changed {
+    bool connected;
+};
+
+ZMK_EVENT_DECLARE(zmk_split_peripheral_status_changed);
@@ -0,0 +1,15 @@
+/*
+ * Host stand-in for <zmk/events/usb_conn_state_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/event_manager.h>
+#include <zmk/usb.h>
+
+struct zmk_usb_conn_state_changed {
+    enum zmk_usb_conn_state conn_state;
+};
+
+ZMK_EVENT_DECLARE(zmk_usb_conn_state_changed);
@@ -0,0 +1,14 @@
+/*
+ * Host stand-in for <zmk/events/wpm_state_changed.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/event_manager.h>
+
+struct zmk_wpm_state_changed {
+    int state;
+};
+
+ZMK_EVENT_DECLARE(zmk_wpm_state_changed);
@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for <zmk/hid.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef uint8_t zmk_mod_flags_t;
+
+zmk_mod_flags_t zmk_hid_get_explicit_mods(void);
@@ -0,0 +1,19 @@
+/*
+ * Host stand-in for <zmk/keymap.h>, with the layer count of config/corne.keymap
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ZMK_KEYMAP_LAYERS_LEN 4
+
+typedef uint8_t zmk_keymap_layer_id_t;
+typedef uint8_t zmk_keymap_layer_index_t;
+
+zmk_keymap_layer_index_t zmk_keymap_highest_layer_active(void);
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t index);
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id);
+bool zmk_keymap_layer_active(zmk_keymap_layer_id_t layer);
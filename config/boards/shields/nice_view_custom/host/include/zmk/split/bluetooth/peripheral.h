@@ -0,0 +1,10 @@
+/*
+ * Host stand-in for <zmk/split/bluetooth/peripheral.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+bool zmk_split_bt_peripheral_is_connected(void);
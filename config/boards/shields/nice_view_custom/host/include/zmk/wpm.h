@@ -0,0 +1,8 @@
+/*
+ * Host stand-in for <zmk/wpm.h>
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+int zmk_wpm_get_state(void);
@@ -0,0 +1,188 @@
+/*
+ * Custom Nice!View host harness: clock and work queue
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <time.h>
+#include <zephyr/kernel.h>
+
+#include "host.h"
+
+int host_log_level = CONFIG_ZMK_LOG_LEVEL;
+
+struct k_work_q k_sys_work_q = {.name = "host"};
+
+static uint64_t clock_base;
+static uint64_t clock_skipped;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t host_clock_ns(void) {
+    if (clock_base == 0) {
+        clock_base = monotonic_ns();
+    }
+    return monotonic_ns() - clock_base + clock_skipped;
+}
+
+void host_clock_skip_to(uint64_t ns) {
+    uint64_t now = host_clock_ns();
+    if (ns > now) {
+        clock_skipped += ns - now;
+    }
+}
+
+// Ready items run first in, first out; timers are kept unsorted, there are
+// only a handful
+static struct k_work *ready_head;
+static struct k_work *ready_tail;
+static struct k_work_delayable *timers;
+
+static void enqueue(struct k_work *work) {
+    work->queued = true;
+    work->next = NULL;
+    if (ready_tail == NULL) {
+        ready_head = work;
+    } else {
+        ready_tail->next = work;
+    }
+    ready_tail = work;
+}
+
+static void timer_remove(struct k_work_delayable *dwork) {
+    for (struct k_work_delayable **link = &timers; *link != NULL; link = &(*link)->next_timer) {
+        if (*link == dwork) {
+            *link = dwork->next_timer;
+            break;
+        }
+    }
+    dwork->scheduled = false;
+}
+
+static void timer_add(struct k_work_delayable *dwork, k_timeout_t delay) {
+    dwork->deadline_ns = host_clock_ns() + delay.ns;
+    dwork->scheduled = true;
+    dwork->next_timer = timers;
+    timers = dwork;
+}
+
+void k_work_init(struct k_work *work, k_work_handler_t handler) {
+    *work = (struct k_work){.handler = handler};
+}
+
+int k_work_submit_to_queue(struct k_work_q *queue, struct k_work *work) {
+    ARG_UNUSED(queue);
+    if (work->queued) {
+        return 0;
+    }
+    enqueue(work);
+    return 1;
+}
+
+int k_work_submit(struct k_work *work) { return k_work_submit_to_queue(&k_sys_work_q, work); }
+
+void k_work_queue_start(struct k_work_q *queue, char *stack, size_t stack_size, int prio,
+                        const struct k_work_queue_config *config) {
+    ARG_UNUSED(stack);
+    ARG_UNUSED(stack_size);
+    ARG_UNUSED(prio);
+    queue->name = config != NULL ? config->name : NULL;
+}
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler) {
+    *dwork = (struct k_work_delayable){.work = {.handler = handler}};
+}
+
+int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+                              k_timeout_t delay) {
+    if (dwork->scheduled || dwork->work.queued) {
+        return 0;
+    }
+    if (delay.ns <= 0) {
+        return k_work_submit_to_queue(queue, &dwork->work);
+    }
+    timer_add(dwork, delay);
+    return 1;
+}
+
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    return k_work_schedule_for_queue(&k_sys_work_q, dwork, delay);
+}
+
+int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+                                k_timeout_t delay) {
+    if (dwork->scheduled) {
+        timer_remove(dwork);
+    }
+    if (delay.ns <= 0) {
+        return k_work_submit_to_queue(queue, &dwork->work);
+    }
+    timer_add(dwork, delay);
+    return 1;
+}
+
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    return k_work_reschedule_for_queue(&k_sys_work_q, dwork, delay);
+}
+
+int k_work_cancel_delayable(struct k_work_delayable *dwork) {
+    if (dwork->scheduled) {
+        timer_remove(dwork);
+    }
+    return 0;
+}
+
+bool k_work_delayable_is_pending(const struct k_work_delayable *dwork) {
+    return dwork->scheduled || dwork->work.queued || dwork->work.running;
+}
+
+static void run_one(void) {
+    struct k_work *work = ready_head;
+
+    ready_head = work->next;
+    if (ready_head == NULL) {
+        ready_tail = NULL;
+    }
+    // Cleared first, so the handler can submit its own item again
+    work->queued = false;
+    work->running = true;
+    work->handler(work);
+    work->running = false;
+}
+
+void host_queue_drain(void) {
+    while (ready_head != NULL) {
+        run_one();
+    }
+}
+
+// The timer due first, if it is due by `until_ns`
+static struct k_work_delayable *next_timer(uint64_t until_ns) {
+    struct k_work_delayable *first = NULL;
+    for (struct k_work_delayable *t = timers; t != NULL; t = t->next_timer) {
+        if (t->deadline_ns <= until_ns && (first == NULL || t->deadline_ns < first->deadline_ns)) {
+            first = t;
+        }
+    }
+    return first;
+}
+
+void host_queue_run_until(uint64_t until_ns) {
+    for (;;) {
+        if (ready_head != NULL) {
+            run_one();
+            continue;
+        }
+        struct k_work_delayable *timer = next_timer(until_ns);
+        if (timer == NULL) {
+            host_clock_skip_to(until_ns);
+            return;
+        }
+        host_clock_skip_to(timer->deadline_ns);
+        timer_remove(timer);
+        enqueue(&timer->work);
+    }
+}
@@ -0,0 +1,38 @@
+/*
+ * LVGL configuration for the host build, matching what Kconfig.defconfig
+ * and the widget's selects give the firmware. Anything not set here keeps
+ * LVGL's default.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#define LV_COLOR_DEPTH 1
+#define LV_DPI_DEF 161
+
+// Zephyr hands LVGL its own pool allocator; the host one is malloc, wrapped
+// by widgets/lvgl_pool.c for the same counters
+#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM_INCLUDE "lvgl_mem.h"
+#define LV_MEM_CUSTOM_ALLOC lvgl_malloc
+#define LV_MEM_CUSTOM_FREE lvgl_free
+#define LV_MEM_CUSTOM_REALLOC lvgl_realloc
+
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE <zephyr/kernel.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (k_uptime_get_32())
+
+#define LV_USE_LOG 0
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_16 1
+#define LV_FONT_MONTSERRAT_18 1
+#define LV_FONT_MONTSERRAT_26 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+
+#define LV_USE_IMG 1
+#define LV_USE_CANVAS 1
+#define LV_USE_LINE 1
+#define LV_USE_LABEL 1
@@ -0,0 +1,227 @@
+/*
+ * Custom Nice!View host event replay
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+
+#include "host.h"
+#include "latency.h"
+#include "queue_stats.h"
+#include "render_sched.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+#include "render_pipe.h"
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Keyboard usage page; its LCTRL .. RGUI usages are the explicit mods
+#define HID_USAGE_KEY 0x07
+#define HID_USAGE_KEY_LEFTCONTROL 0xE0
+#define HID_USAGE_KEY_RIGHT_GUI 0xE7
+// Queue time after the last event, for its frame to render and flush
+#define REPLAY_SETTLE_MS 1000
+#define REPLAY_LINE_MAX 128
+
+// A stream is one event per line, "<ms> <event> <args>", in the format
+// CONFIG_NICE_VIEW_CUSTOM_WIDGET_RECORD logs after "nvrec ", so a captured
+// device log replays as is. '#' starts a comment.
+//   <ms> key <keycode> down|up
+//   <ms> layer <id> on|off
+//   <ms> wpm <value>
+//   <ms> battery <percent>
+//   <ms> activity <state>        (enum zmk_activity_state: 0 active, 1 idle)
+struct replay {
+    double speed;
+    uint64_t start_ns;
+    int64_t first_ms;
+    bool started;
+    uint32_t events;
+};
+
+static int parse_on(const char *word, const char *on, const char *off, bool *value) {
+    if (strcmp(word, on) == 0) {
+        *value = true;
+    } else if (strcmp(word, off) == 0) {
+        *value = false;
+    } else {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+// The firmware updates its state, then raises the event
+static int replay_event(const char *kind, unsigned long arg, const char *word) {
+    bool on;
+
+    if (strcmp(kind, "key") == 0) {
+        if (parse_on(word, "down", "up", &on) < 0) {
+            return -EINVAL;
+        }
+        if (arg >= HID_USAGE_KEY_LEFTCONTROL && arg <= HID_USAGE_KEY_RIGHT_GUI) {
+            zmk_mod_flags_t mod = BIT(arg - HID_USAGE_KEY_LEFTCONTROL);
+            host_zmk.explicit_mods = on ? host_zmk.explicit_mods | mod
+                                        : host_zmk.explicit_mods & ~mod;
+        }
+        return raise_zmk_keycode_state_changed((struct zmk_keycode_state_changed){
+            .usage_page = HID_USAGE_KEY,
+            .keycode = arg,
+            .state = on,
+            .timestamp = k_uptime_get(),
+        });
+    }
+    if (strcmp(kind, "layer") == 0) {
+        if (arg >= 32 || parse_on(word, "on", "off", &on) < 0) {
+            return -EINVAL;
+        }
+        host_zmk.layer_state =
+            on ? host_zmk.layer_state | BIT(arg) : host_zmk.layer_state & ~BIT(arg);
+        return raise_zmk_layer_state_changed((struct zmk_layer_state_changed){
+            .layer = arg,
+            .state = on,
+            .timestamp = k_uptime_get(),
+        });
+    }
+    if (strcmp(kind, "wpm") == 0) {
+        host_zmk.wpm = arg;
+        return raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = arg});
+    }
+    if (strcmp(kind, "battery") == 0) {
+        host_zmk.battery = MIN(arg, 100);
+        return raise_zmk_battery_state_changed(
+            (struct zmk_battery_state_changed){.state_of_charge = host_zmk.battery});
+    }
+    if (strcmp(kind, "activity") == 0) {
+        if (arg > ZMK_ACTIVITY_SLEEP) {
+            return -EINVAL;
+        }
+        host_zmk.activity = arg;
+        return raise_zmk_activity_state_changed(
+            (struct zmk_activity_state_changed){.state = host_zmk.activity});
+    }
+    return -EINVAL;
+}
+
+static int replay_line(struct replay *replay, char *line) {
+    char *record = strstr(line, "nvrec ");
+    char *text = record != NULL ? record + strlen("nvrec ") : line;
+    char *comment = strchr(text, '#');
+    char kind[16];
+    char word[16] = "";
+    long long ms;
+    unsigned long arg;
+
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+    int fields = sscanf(text, "%lld %15s %li %15s", &ms, kind, &arg, word);
+    if (fields <= 0) {
+        // Blank, a comment, or a log line that is not a record
+        return 0;
+    }
+    if (fields < 3) {
+        return -EINVAL;
+    }
+
+    if (!replay->started) {
+        replay->started = true;
+        replay->first_ms = ms;
+    }
+    // Everything queued up to the event's time runs first, as it would have
+    uint64_t offset_ns = (uint64_t)((ms - replay->first_ms) * NSEC_PER_MSEC / replay->speed);
+    host_queue_run_until(replay->start_ns + offset_ns);
+
+    replay->events++;
+    return replay_event(kind, arg, word);
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-s speed] [-f flush_us] stream\n", name);
+}
+
+int main(int argc, char **argv) {
+    struct replay replay = {.speed = 1.0};
+    uint32_t flush_us = 0;
+    char line[REPLAY_LINE_MAX];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:f:")) != -1) {
+        switch (opt) {
+        case 's':
+            replay.speed = strtod(optarg, NULL);
+            break;
+        case 'f':
+            flush_us = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (optind != argc - 1 || replay.speed <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *stream = fopen(argv[optind], "r");
+    if (stream == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    host_display_init(flush_us);
+    host_screen_start();
+    // Counters cover the replay only, not the boot frames
+    struct render_sched_stats sched_before;
+    render_sched_get_stats(&sched_before);
+    queue_stats_reset();
+    replay.start_ns = host_clock_ns();
+
+    for (int n = 1; fgets(line, sizeof(line), stream) != NULL; n++) {
+        if (replay_line(&replay, line) < 0) {
+            fprintf(stderr, "%s:%d: bad event\n", argv[optind], n);
+            fclose(stream);
+            return 1;
+        }
+    }
+    fclose(stream);
+    host_queue_run_for(REPLAY_SETTLE_MS);
+
+    struct render_sched_stats sched;
+    struct host_display_stats display;
+    render_sched_get_stats(&sched);
+    host_display_get_stats(&display);
+
+    LOG_INF("replay: %u events in %llu ms at %.2fx, flush %u us", replay.events,
+            (unsigned long long)((host_clock_ns() - replay.start_ns) / NSEC_PER_MSEC),
+            replay.speed, flush_us);
+    LOG_INF("replay: %u frames, %u flushes, %u px flushed", sched.frames - sched_before.frames,
+            display.flushes, display.flushed_px);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    LOG_INF("replay: %u suppressed while idle, %u catch-up frames",
+            sched.suppressed - sched_before.suppressed, sched.catchups - sched_before.catchups);
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    struct render_pipe_stats pipe;
+    render_pipe_get_stats(&pipe);
+    LOG_INF("replay: %u frames drawn off the display queue, %u while one was in flight, "
+            "draw max %u us",
+            pipe.frames, pipe.busy, pipe.draw_us_max);
+#endif
+    queue_stats_dump(NULL);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+    latency_dump(NULL);
+#endif
+    return 0;
+}
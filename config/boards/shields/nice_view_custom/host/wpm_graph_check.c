@@ -0,0 +1,108 @@
+/*
+ * Custom Nice!View WPM graph scroll check
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "scratch.h"
+#include "wpm_graph.h"
+#include "wpm_history.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define CHECK_UPDATES 200000
+// Only the first few mismatches are logged
+#define CHECK_LOG_MAX 4
+
+// The graph geometry of custom_status.c
+#define GRAPH_X 2
+#define GRAPH_W 64
+#define GRAPH_Y_BOTTOM 63
+#define GRAPH_H 36
+
+// xorshift32, so a failing run reproduces on every libc
+static uint32_t rng_state = 0x6b8b4567;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Mostly steady typing with small drifts, plus jumps that move the window's
+// min and max; now and then several samples land between two updates
+static uint8_t next_wpm(uint8_t last) {
+    uint32_t roll = rng() % 100;
+
+    if (roll < 60) {
+        return last;
+    }
+    if (roll < 90) {
+        return (uint8_t)(last + rng() % 7 - 3);
+    }
+    return rng() % 160;
+}
+
+static int buf_diff_bits(const struct wpm_graph *a, const struct wpm_graph *b) {
+    int bits = 0;
+
+    for (size_t i = 0; i < sizeof(a->buf); i++) {
+        bits += __builtin_popcount(a->buf[i] ^ b->buf[i]);
+    }
+    return bits;
+}
+
+// After every update the scrolled graph must match one redrawn from scratch.
+// Lengths that give each sample its own evenly spaced column must have
+// scrolled; the others must never scroll. Exits nonzero otherwise.
+int main(void) {
+    static struct wpm_history history;
+    static struct wpm_graph graph;
+    static struct wpm_graph rebuilt;
+    uint32_t step = DIV_ROUND_UP(WPM_HISTORY_LEN, GRAPH_W);
+    uint32_t cols = DIV_ROUND_UP(WPM_HISTORY_LEN, step);
+    bool scrollable = step == 1 && cols > 1 && (GRAPH_W - 1) % (cols - 1) == 0;
+    uint32_t bad = 0;
+
+    wpm_history_init(&history);
+    wpm_graph_init(&graph, GRAPH_X, GRAPH_W, GRAPH_Y_BOTTOM, GRAPH_H);
+
+    for (int i = 0; i < CHECK_UPDATES; i++) {
+        uint8_t wpm = next_wpm(wpm_history_latest(&history));
+        int samples = rng() % 100 < 10 ? 1 + rng() % 5 : 1;
+
+        for (int k = 0; k < samples; k++) {
+            wpm_history_push(&history, wpm);
+        }
+
+        scratch_reset();
+        wpm_graph_update(&graph, &history);
+        wpm_graph_init(&rebuilt, GRAPH_X, GRAPH_W, GRAPH_Y_BOTTOM, GRAPH_H);
+        scratch_reset();
+        wpm_graph_update(&rebuilt, &history);
+
+        if (memcmp(graph.buf, rebuilt.buf, sizeof(graph.buf)) != 0) {
+            if (++bad <= CHECK_LOG_MAX) {
+                LOG_ERR("update %d (sample %u) differs in %d pixels", i, history.total,
+                        buf_diff_bits(&graph, &rebuilt));
+            }
+            // Start over from the good picture so one bad scroll counts once
+            wpm_graph_invalidate(&graph);
+        }
+    }
+
+    LOG_INF("WPM_HISTORY %d: %u of %u updates differ, %u scrolls, %u rebuilds", WPM_HISTORY_LEN,
+            bad, CHECK_UPDATES, graph.scrolls, graph.rebuilds);
+    if (scrollable != (graph.scrolls > 0)) {
+        LOG_ERR("WPM_HISTORY %d should %s", WPM_HISTORY_LEN,
+                scrollable ? "scroll but never did" : "never scroll but did");
+        return 1;
+    }
+    return bad != 0;
+}
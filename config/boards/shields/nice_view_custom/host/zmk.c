@@ -0,0 +1,125 @@
+/*
+ * Custom Nice!View host harness: ZMK event manager and state stubs
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zmk/activity.h>
+#include <zmk/battery.h>
+#include <zmk/ble.h>
+#include <zmk/display.h>
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+#include <zmk/hid.h>
+#include <zmk/keymap.h>
+#include <zmk/split/bluetooth/peripheral.h>
+#include <zmk/usb.h>
+#include <zmk/wpm.h>
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/split_peripheral_status_changed.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+
+#include "host.h"
+
+ZMK_EVENT_IMPL(zmk_activity_state_changed);
+ZMK_EVENT_IMPL(zmk_battery_state_changed);
+ZMK_EVENT_IMPL(zmk_peripheral_battery_state_changed);
+ZMK_EVENT_IMPL(zmk_ble_active_profile_changed);
+ZMK_EVENT_IMPL(zmk_endpoint_changed);
+ZMK_EVENT_IMPL(zmk_keycode_state_changed);
+ZMK_EVENT_IMPL(zmk_layer_state_changed);
+ZMK_EVENT_IMPL(zmk_split_peripheral_status_changed);
+ZMK_EVENT_IMPL(zmk_usb_conn_state_changed);
+ZMK_EVENT_IMPL(zmk_wpm_state_changed);
+
+#define SUBSCRIPTIONS_MAX 32
+
+struct subscription {
+    const struct zmk_event_type *type;
+    const struct zmk_listener *listener;
+};
+
+static struct subscription subscriptions[SUBSCRIPTIONS_MAX];
+static int subscription_count;
+
+void host_event_subscribe(const struct zmk_event_type *type, const struct zmk_listener *listener) {
+    __ASSERT(subscription_count < SUBSCRIPTIONS_MAX, "too many subscriptions");
+    subscriptions[subscription_count++] = (struct subscription){type, listener};
+}
+
+int host_event_raise(const zmk_event_t *event) {
+    for (int i = 0; i < subscription_count; i++) {
+        if (subscriptions[i].type == event->event) {
+            subscriptions[i].listener->callback(event);
+        }
+    }
+    return 0;
+}
+
+// A freshly booted, USB-connected central on the base layer
+struct host_zmk host_zmk = {
+    .battery = 87,
+    .usb_powered = true,
+    .activity = ZMK_ACTIVITY_ACTIVE,
+    .layer_state = BIT(0),
+    .layer_ids = {0, 1, 2, 3},
+    .endpoint = {.transport = ZMK_TRANSPORT_USB},
+    .ble_connected = true,
+    .split_connected = true,
+};
+
+struct k_work_q *zmk_display_work_q(void) { return &k_sys_work_q; }
+
+enum zmk_activity_state zmk_activity_get_state(void) { return host_zmk.activity; }
+
+uint8_t zmk_battery_state_of_charge(void) { return host_zmk.battery; }
+
+bool zmk_usb_is_powered(void) { return host_zmk.usb_powered; }
+
+int zmk_wpm_get_state(void) { return host_zmk.wpm; }
+
+zmk_mod_flags_t zmk_hid_get_explicit_mods(void) { return host_zmk.explicit_mods; }
+
+zmk_keymap_layer_index_t zmk_keymap_highest_layer_active(void) {
+    for (int i = ZMK_KEYMAP_LAYERS_LEN - 1; i > 0; i--) {
+        if (host_zmk.layer_state & BIT(host_zmk.layer_ids[i])) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t index) {
+    return index < ZMK_KEYMAP_LAYERS_LEN ? host_zmk.layer_ids[index] : UINT8_MAX;
+}
+
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id) {
+    return layer_id < ZMK_KEYMAP_LAYERS_LEN ? host_zmk.layer_names[layer_id] : NULL;
+}
+
+bool zmk_keymap_layer_active(zmk_keymap_layer_id_t layer) {
+    return (host_zmk.layer_state & BIT(layer)) != 0;
+}
+
+struct zmk_endpoint_instance zmk_endpoints_selected(void) { return host_zmk.endpoint; }
+
+bool zmk_endpoint_instance_eq(struct zmk_endpoint_instance a, struct zmk_endpoint_instance b) {
+    if (a.transport != b.transport) {
+        return false;
+    }
+    return a.transport == ZMK_TRANSPORT_USB || a.ble.profile_index == b.ble.profile_index;
+}
+
+int zmk_ble_active_profile_index(void) { return host_zmk.ble_profile; }
+
+bool zmk_ble_active_profile_is_connected(void) { return host_zmk.ble_connected; }
+
+bool zmk_ble_active_profile_is_open(void) { return host_zmk.ble_open; }
+
+bool zmk_split_bt_peripheral_is_connected(void) { return host_zmk.split_connected; }
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Collect "nvbench" lines from a captured nice!view log into a JSON result
+file and optionally compare them against a baseline result.
+
+Frame times are compared in cycles (cyc_avg), so a baseline only means
+something when it comes from a board with the same cycle rate (cyc_hz)."""
+
+import argparse
+import json
+import re
+import sys
+
+BENCH_RE = re.compile(r"nvbench (\{.*\})")
+
+
+def parse_log(path):
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as log:
+        for line in log:
+            match = BENCH_RE.search(line)
+            if match:
+                entry = json.loads(match.group(1))
+                results[entry["case"]] = entry
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("log", help="captured device log (RTT, USB logging, ...)")
+    parser.add_argument("-o", "--output", default="bench.json", help="result file to write")
+    parser.add_argument("-b", "--baseline", help="previous result file to compare against")
+    parser.add_argument("-t", "--threshold", type=float, default=10.0,
+                        help="allowed cyc_avg regression in percent (default 10)")
+    args = parser.parse_args()
+
+    results = parse_log(args.log)
+    if not results:
+        print(f"no nvbench lines in {args.log}", file=sys.stderr)
+        return 1
+
+    with open(args.output, "w", encoding="utf-8") as out:
+        json.dump(results, out, indent=2, sort_keys=True)
+
+    # A/B cases time the old implementation too, and fail if the two
+    # produced different bytes
+    failed = False
+    for case, entry in sorted(results.items()):
+        if "cyc_lvgl" not in entry:
+            continue
+        speedup = 100.0 * (entry["cyc_lvgl"] - entry["cyc_avg"]) / max(entry["cyc_lvgl"], 1)
+        mismatch = entry["diff_bytes"] != 0
+        failed |= mismatch
+        print(f"{case:14} {entry['cyc_avg']:>9} cyc  lvgl {entry['cyc_lvgl']} cyc  "
+              f"{speedup:.1f}% faster  diff_bytes {entry['diff_bytes']}"
+              f"{'  MISMATCH' if mismatch else ''}")
+
+    if not args.baseline:
+        return 1 if failed else 0
+
+    with open(args.baseline, encoding="utf-8") as base_file:
+        baseline = json.load(base_file)
+
+    for case, entry in sorted(results.items()):
+        base = baseline.get(case)
+        if base is None or "cyc_avg" not in base:
+            print(f"{case:14} {entry['cyc_avg']:>9} cyc  (new)")
+            continue
+        if base.get("cyc_hz") != entry["cyc_hz"]:
+            print(f"{case:14} {entry['cyc_avg']:>9} cyc  (baseline at "
+                  f"{base.get('cyc_hz', '?')} Hz, this run at {entry['cyc_hz']} Hz)")
+            continue
+        delta = 100.0 * (entry["cyc_avg"] - base["cyc_avg"]) / max(base["cyc_avg"], 1)
+        regressed = delta > args.threshold
+        failed |= regressed
+        changes = ""
+        for key in ("backend", "layout"):
+            if entry.get(key) != base.get(key):
+                changes += f"  {base.get(key, '?')} -> {entry.get(key, '?')}"
+        # Refresh cases count invalidated pixels instead of allocations
+        if "inv_px" in entry:
+            detail = f"inv_px {base.get('inv_px', '?')} -> {entry['inv_px']}"
+        elif "cyc_lvgl" in entry:
+            detail = f"lvgl {base.get('cyc_lvgl', '?')} -> {entry['cyc_lvgl']} cyc"
+        else:
+            detail = f"allocs {entry['allocs']}  pool_peak {entry['pool_peak']}"
+        print(f"{case:14} {entry['cyc_avg']:>9} cyc  {delta:+6.1f}%  {detail}"
+              f"{changes}{'  REGRESSION' if regressed else ''}")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Convert PBM art into the nice!view widget assets and report their flash
+size against the LVGL indexed images they replace.
+
+Every asset becomes an LVGL indexed image (for lv_img and the canvas
+backend). Sprites additionally become struct fb_sprite bitmaps, packed 1bpp
+and already rotated into the region framebuffer layout, so the direct
+framebuffer backend can blit them with shifts and masks instead of decoding
+a palette per pixel. A sprite can have a mask PBM; pixels outside it are
+left untouched.
+"""
+
+import argparse
+import os
+import sys
+
+
+def read_pbm(path):
+    """Return rows of 0/1 pixels, 1 = black, from a plain (P1) or raw (P4) PBM."""
+    with open(path, "rb") as pbm:
+        data = pbm.read()
+
+    pos = 0
+
+    def token():
+        nonlocal pos
+        while True:
+            while pos < len(data) and data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b"#":
+                while pos < len(data) and data[pos:pos + 1] not in b"\r\n":
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace() and data[pos:pos + 1] != b"#":
+            pos += 1
+        return data[start:pos]
+
+    magic = token()
+    width = int(token())
+    height = int(token())
+
+    if magic == b"P4":
+        pos += 1
+        stride = (width + 7) // 8
+        return [[(data[pos + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                for y in range(height)]
+    if magic != b"P1":
+        raise ValueError(f"{path}: not a PBM file")
+
+    # Plain PBM digits need not be separated, so read them one by one
+    bits = [int(chr(c)) for c in data[pos:] if chr(c) in "01"]
+    if len(bits) < width * height:
+        raise ValueError(f"{path}: expected {width}x{height} pixels")
+    return [bits[y * width:(y + 1) * width] for y in range(height)]
+
+
+def pack_row(bits):
+    packed = bytearray((len(bits) + 7) // 8)
+    for i, bit in enumerate(bits):
+        packed[i // 8] |= bit << (7 - i % 8)
+    return packed
+
+
+def lvgl_image(pixels, mask):
+    """Indexed image bytes, palette first: without a mask 1bpp black/white,
+    with one 2bpp transparent/white/black."""
+    if mask is None:
+        palette = bytes([0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF])
+        rows = [pack_row([1 - bit for bit in row]) for row in pixels]
+        return palette + b"".join(rows), "LV_IMG_CF_INDEXED_1BIT"
+
+    palette = bytes([0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+                     0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00])
+    data = bytearray()
+    for row, mask_row in zip(pixels, mask):
+        index = [(2 if bit else 1) if opaque else 0 for bit, opaque in zip(row, mask_row)]
+        packed = bytearray((2 * len(index) + 7) // 8)
+        for i, value in enumerate(index):
+            packed[i // 4] |= value << (6 - 2 * (i % 4))
+        data += packed
+    return palette + bytes(data), "LV_IMG_CF_INDEXED_2BIT"
+
+
+def rotate(pixels):
+    """Region layout: row x of the result holds logical column x, and bit k
+    of that row is logical row height - 1 - k, like the rotated canvases."""
+    height = len(pixels)
+    width = len(pixels[0])
+    return [pack_row([pixels[height - 1 - k][x] for k in range(height)]) for x in range(width)]
+
+
+def c_array(name, data, indent="    "):
+    lines = ["static const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST uint8_t "
+             f"{name}[] = {{"]
+    for i in range(0, len(data), 12):
+        lines.append(indent + " ".join(f"0x{byte:02x}," for byte in data[i:i + 12]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def load(name, paths):
+    pixels = read_pbm(paths[0])
+    mask = read_pbm(paths[1]) if len(paths) > 1 else None
+    if mask is not None and (len(mask) != len(pixels) or len(mask[0]) != len(pixels[0])):
+        raise ValueError(f"{name}: mask size differs from the image")
+    if mask is not None:
+        pixels = [[bit & opaque for bit, opaque in zip(row, mask_row)]
+                  for row, mask_row in zip(pixels, mask)]
+    return pixels, mask
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--image", nargs="+", action="append", default=[],
+                        metavar=("NAME", "PBM"), help="LVGL image only")
+    parser.add_argument("--sprite", nargs="+", action="append", default=[],
+                        metavar=("NAME", "PBM"), help="LVGL image and fb_sprite, PBM [MASK]")
+    parser.add_argument("--out", required=True, help="output directory")
+    args = parser.parse_args()
+
+    assets = [(spec[0], spec[1:], False) for spec in args.image]
+    assets += [(spec[0], spec[1:], True) for spec in args.sprite]
+    for name, paths, _ in assets:
+        if not 1 <= len(paths) <= 2:
+            parser.error(f"{name}: expected a PBM and an optional mask")
+
+    os.makedirs(args.out, exist_ok=True)
+    header = ["/* Generated by gen_assets.py, do not edit */", "", "#pragma once", "",
+              "#include <lvgl.h>", "", '#include "fb.h"', ""]
+    source = ["/* Generated by gen_assets.py, do not edit */", "",
+              '#include "nv_assets.h"', ""]
+    report = []
+
+    for name, paths, sprite in assets:
+        pixels, mask = load(name, paths)
+        width = len(pixels[0])
+        height = len(pixels)
+        sources = ", ".join(os.path.basename(path) for path in paths)
+
+        image, color_format = lvgl_image(pixels, mask)
+        source += [f"// {name}: {width}x{height} from {sources}",
+                   c_array(f"{name}_map", image), "",
+                   f"const lv_img_dsc_t {name} = {{",
+                   f"    .header.cf = {color_format},",
+                   f"    .header.w = {width},",
+                   f"    .header.h = {height},",
+                   f"    .data_size = {len(image)},",
+                   f"    .data = {name}_map,",
+                   "};", ""]
+        header.append(f"extern const lv_img_dsc_t {name};")
+        after = len(image)
+
+        if sprite:
+            opaque = mask if mask is not None else [[1] * width for _ in range(height)]
+            ink = rotate(pixels)
+            stride = len(ink[0])
+            source += [c_array(f"{name}_ink", b"".join(ink)), "",
+                       c_array(f"{name}_mask", b"".join(rotate(opaque))), "",
+                       f"const struct fb_sprite {name}_sprite = {{",
+                       f"    .w = {width},",
+                       f"    .h = {height},",
+                       f"    .stride = {stride},",
+                       f"    .ink = {name}_ink,",
+                       f"    .mask = {name}_mask,",
+                       "};", ""]
+            header.append(f"extern const struct fb_sprite {name}_sprite;")
+            after = 2 * width * stride
+
+        report.append((name, f"{width}x{height}", len(image), after, sprite))
+
+    with open(os.path.join(args.out, "nv_assets.h"), "w", encoding="utf-8") as out:
+        out.write("\n".join(header) + "\n")
+    with open(os.path.join(args.out, "nv_assets.c"), "w", encoding="utf-8") as out:
+        out.write("\n".join(source))
+
+    # The LVGL indexed image every asset used to be linked as, against what the
+    # direct framebuffer backend links: the sprite for sprites, else the image
+    # (the unused variant is dropped by --gc-sections)
+    print(f"{'asset':10} {'size':>7} {'lv_img':>8} {'direct fb':>10}")
+    for name, size, before, after, sprite in report:
+        kind = "sprite" if sprite else "lv_img"
+        print(f"{name:10} {size:>7} {before:>7}B {after:>9}B  {kind}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Generate Montserrat subsets holding only the glyphs the nice!view widgets
+draw, and report their size against LVGL's built-in fonts.
+
+Every subset keeps printable ASCII (0x20-0x7E): layer names can change at
+runtime, so the keymap seen at build time does not bound the text. On top of
+that come the LV_SYMBOL_* icons the widget sources use, and any non-ASCII
+characters in their string literals or the keymap's layer names. A character
+outside the subset, e.g. an accented letter in a name set at runtime, is
+skipped when drawn, as LVGL does for any glyph a font lacks.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+STRING_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+SYMBOL_RE = re.compile(r"\bLV_SYMBOL_([A-Z0-9_]+)\b")
+SYMBOL_DEF_RE = re.compile(r'#define\s+LV_SYMBOL_([A-Z0-9_]+)\s+"((?:\\x[0-9A-Fa-f]{2})+)"')
+PRINTABLE_ASCII = {chr(c) for c in range(0x20, 0x7F)}
+LAYER_NAME_RE = re.compile(r'\b(?:display-name|label)\s*=\s*"([^"]*)"')
+
+
+def c_unescape(text):
+    return text.encode("latin-1", "backslashreplace").decode("unicode_escape")
+
+
+def load_symbols(lvgl_dir):
+    path = os.path.join(lvgl_dir, "src", "font", "lv_symbol_def.h")
+    symbols = {}
+    with open(path, encoding="utf-8") as header:
+        for name, escaped in SYMBOL_DEF_RE.findall(header.read()):
+            raw = bytes(int(byte, 16) for byte in escaped.split("\\x")[1:])
+            symbols[name] = ord(raw.decode("utf-8"))
+    return symbols
+
+
+def collect_glyphs(sources, keymap, symbols):
+    text_chars = set(PRINTABLE_ASCII)
+    symbol_chars = set()
+
+    for path in sources:
+        with open(path, encoding="utf-8") as source:
+            for line in source:
+                stripped = line.strip()
+                if stripped.startswith("#include") or "LOG_" in stripped:
+                    continue
+                for literal in STRING_RE.findall(line):
+                    text_chars.update(c_unescape(literal))
+                for name in SYMBOL_RE.findall(line):
+                    if name in symbols:
+                        symbol_chars.add(symbols[name])
+
+    if keymap:
+        with open(keymap, encoding="utf-8") as keymap_file:
+            for name in LAYER_NAME_RE.findall(keymap_file.read()):
+                text_chars.update(name)
+
+    return sorted(ord(c) for c in text_chars if c.isprintable()), sorted(symbol_chars)
+
+
+def font_size(path):
+    """Return (glyph count, bitmap bytes) of an LVGL font source file."""
+    with open(path, encoding="utf-8") as font:
+        source = font.read()
+    bitmap = re.search(r"glyph_bitmap\[\]\s*=\s*\{(.*?)\};", source, re.S)
+    bitmap_bytes = len(re.findall(r"0x[0-9a-fA-F]{2}", bitmap.group(1))) if bitmap else 0
+    return source.count(".bitmap_index"), bitmap_bytes
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--lvgl", required=True, help="LVGL module directory")
+    parser.add_argument("--lv-font-conv", default="lv_font_conv", help="lv_font_conv executable")
+    parser.add_argument("--keymap", help="keymap to take layer names from")
+    parser.add_argument("--sizes", type=int, nargs="+", required=True)
+    parser.add_argument("--out", required=True, help="output directory")
+    parser.add_argument("sources", nargs="+", help="widget sources to scan")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.lvgl)
+    text, icons = collect_glyphs(args.sources, args.keymap, symbols)
+    font_dir = os.path.join(args.lvgl, "scripts", "built_in_font")
+    os.makedirs(args.out, exist_ok=True)
+
+    print(f"font subset: {len(text)} text glyphs, {len(icons)} symbols")
+    for size in args.sizes:
+        name = f"nv_font_montserrat_{size}"
+        output = os.path.join(args.out, f"{name}.c")
+        command = [
+            args.lv_font_conv, "--bpp", "4", "--size", str(size), "--no-compress",
+            "--font", os.path.join(font_dir, "Montserrat-Medium.ttf"),
+            "-r", ",".join(hex(c) for c in text),
+        ]
+        if icons:
+            command += [
+                "--font", os.path.join(font_dir, "FontAwesome5-Solid+Brands+Regular.woff"),
+                "-r", ",".join(hex(c) for c in icons),
+            ]
+        command += ["--format", "lvgl", "--lv-font-name", name, "-o", output]
+        subprocess.run(command, check=True)
+
+        glyphs, bitmap = font_size(output)
+        full_glyphs, full_bitmap = font_size(
+            os.path.join(args.lvgl, "src", "font", f"lv_font_montserrat_{size}.c"))
+        saved = 100.0 * (1 - bitmap / full_bitmap) if full_bitmap else 0.0
+        print(f"  montserrat_{size}: {glyphs} glyphs / {bitmap} B bitmap "
+              f"(built-in {full_glyphs} glyphs / {full_bitmap} B, -{saved:.0f}%)")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
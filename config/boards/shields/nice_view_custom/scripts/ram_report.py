@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Split the static RAM of a Zephyr build into display and the rest of the
+firmware, from the GNU ld map file (zephyr.map)."""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+MEMORY_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+# Input section, on one line or with the address and size wrapped to the next
+SECTION_RE = re.compile(r"^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?$")
+WRAPPED_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+# First match wins; checked against the object path
+CATEGORIES = [
+    ("widget", re.compile(r"nice_view_custom|shields/")),
+    ("lvgl", re.compile(r"lvgl", re.IGNORECASE)),
+    ("display driver", re.compile(r"ls0xx|drivers/display|/display/")),
+]
+DISPLAY = {"widget", "lvgl", "display driver"}
+
+
+def ram_regions(lines):
+    regions = []
+    in_table = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            in_table = True
+            continue
+        if line.startswith("Linker script and memory map"):
+            break
+        match = MEMORY_RE.match(line) if in_table else None
+        if match and "RAM" in match.group(1).upper():
+            start = int(match.group(2), 16)
+            regions.append((start, start + int(match.group(3), 16)))
+    return regions
+
+
+def input_sections(lines):
+    mapped = False
+    pending = None
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            mapped = True
+            continue
+        if not mapped:
+            continue
+        if pending is not None:
+            wrapped = WRAPPED_RE.match(line)
+            if wrapped:
+                yield pending, int(wrapped.group(1), 16), int(wrapped.group(2), 16), \
+                    wrapped.group(3)
+            pending = None
+            continue
+        match = SECTION_RE.match(line)
+        if not match or match.group(1).startswith("*"):
+            continue
+        if match.group(2) is None:
+            pending = match.group(1)
+        else:
+            yield match.group(1), int(match.group(2), 16), int(match.group(3), 16), \
+                match.group(4)
+
+
+def category(obj):
+    for name, pattern in CATEGORIES:
+        if pattern.search(obj):
+            return name
+    return "rest"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("map", help="linker map file, e.g. build/zephyr/zephyr.map")
+    parser.add_argument("-n", "--top", type=int, default=8,
+                        help="largest display symbols to list (default 8)")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as map_file:
+        lines = map_file.read().splitlines()
+
+    regions = ram_regions(lines)
+    if not regions:
+        print(f"no RAM region in {args.map}", file=sys.stderr)
+        return 1
+
+    totals = defaultdict(int)
+    symbols = []
+    for name, addr, size, obj in input_sections(lines):
+        if size == 0 or not any(start <= addr < end for start, end in regions):
+            continue
+        kind = category(obj)
+        totals[kind] += size
+        if kind in DISPLAY:
+            symbols.append((size, name, kind))
+
+    ram = sum(totals.values())
+    display = sum(size for kind, size in totals.items() if kind in DISPLAY)
+    print(f"static RAM {ram} bytes")
+    for kind in ["widget", "lvgl", "display driver", "rest"]:
+        print(f"  {kind:15} {totals[kind]:>7}  {100.0 * totals[kind] / max(ram, 1):5.1f}%")
+    print(f"  {'display total':15} {display:>7}  {100.0 * display / max(ram, 1):5.1f}%")
+
+    if args.top > 0 and symbols:
+        print("largest display sections")
+        for size, name, kind in sorted(symbols, reverse=True)[:args.top]:
+            print(f"  {size:>7}  {name}  ({kind})")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
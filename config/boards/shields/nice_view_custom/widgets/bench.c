@@ -0,0 +1,193 @@
+/*
+ * Custom Nice!View render benchmark
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <string.h>
+#include <lvgl.h>
+
+// Lets bench_report.py tell backends and screen layouts apart
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+#define BENCH_BACKEND "fb"
+#else
+#define BENCH_BACKEND "lvgl"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+// Single canvas, double buffered; every case includes publishing the frame
+#define BENCH_LAYOUT "double"
+#elif IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+#define BENCH_LAYOUT "single"
+#else
+#define BENCH_LAYOUT "canvases"
+#endif
+
+#include "bench.h"
+#include "lvgl_pool.h"
+#include "scratch.h"
+#include "util.h"
+
+struct bench_timing {
+    uint64_t total_cyc;
+    uint32_t min_cyc;
+    uint32_t max_cyc;
+};
+
+static void timing_add(struct bench_timing *timing, uint32_t cyc) {
+    timing->total_cyc += cyc;
+    timing->min_cyc = MIN(timing->min_cyc, cyc);
+    timing->max_cyc = MAX(timing->max_cyc, cyc);
+}
+
+static void bench_time(struct bench_timing *timing, uint32_t frames, render_bench_fn fn,
+                       void *data) {
+    *timing = (struct bench_timing){.min_cyc = UINT32_MAX};
+    for (uint32_t i = 0; i < frames; i++) {
+        uint32_t start = k_cycle_get_32();
+        fn(data);
+        timing_add(timing, k_cycle_get_32() - start);
+    }
+}
+
+// Frame times are logged in hardware cycles, the unit they are measured in,
+// with the cycle rate so they can be compared across boards, plus the
+// average in ns for reading at a glance
+#define BENCH_TIMING_FMT                                                                          \
+    "\"cyc_hz\":%u,\"cyc_avg\":%u,\"cyc_min\":%u,\"cyc_max\":%u,\"ns_avg\":%u"
+#define BENCH_TIMING_ARGS(timing, frames)                                                         \
+    sys_clock_hw_cycles_per_sec(), timing_cyc_avg(timing, frames), (timing)->min_cyc,             \
+        (timing)->max_cyc, timing_ns_avg(timing, frames)
+
+static uint32_t timing_cyc_avg(const struct bench_timing *timing, uint32_t frames) {
+    return (uint32_t)(timing->total_cyc / frames);
+}
+
+static uint32_t timing_ns_avg(const struct bench_timing *timing, uint32_t frames) {
+    return (uint32_t)k_cyc_to_ns_floor64(timing->total_cyc / frames);
+}
+
+void render_bench_run(const char *name, render_bench_fn fn, void *data) {
+    const uint32_t frames = CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES;
+    struct lvgl_pool_stats before;
+    struct lvgl_pool_stats after;
+    struct bench_timing timing;
+
+    lvgl_pool_start_window();
+    lvgl_pool_get_stats(&before);
+    bench_time(&timing, frames, fn, data);
+    lvgl_pool_get_stats(&after);
+
+    LOG_INF("nvbench {\"case\":\"%s\",\"backend\":\"%s\",\"layout\":\"%s\",\"frames\":%u,"
+            BENCH_TIMING_FMT ",\"allocs\":%u,\"pool_peak\":%u,\"pool_base\":%u}",
+            name, BENCH_BACKEND, BENCH_LAYOUT, frames, BENCH_TIMING_ARGS(&timing, frames),
+            after.allocs - before.allocs, (uint32_t)after.window_peak, (uint32_t)before.in_use);
+}
+
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1) && !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+
+// Both sides of the A/B case rotate the same scratch canvas. The LVGL side
+// is what rotate_canvas did before rotate_1bpp: copy the canvas and
+// lv_canvas_transform the copy by 90 degrees into a true color canvas.
+static lv_color_t ab_copy[CANVAS_SIZE * CANVAS_SIZE];
+static lv_color_t ab_lvgl_buf[CANVAS_SIZE * CANVAS_SIZE];
+static lv_obj_t *ab_lvgl_canvas;
+static uint8_t ab_packed[CANVAS_STRIDE_1BPP * CANVAS_SIZE];
+static uint8_t ab_1bpp[CANVAS_STRIDE_1BPP * CANVAS_SIZE];
+
+static void rotate_lvgl(void *data) {
+    ARG_UNUSED(data);
+    memcpy(ab_copy, scratch_canvas_buf(), sizeof(ab_copy));
+    lv_img_dsc_t img = {
+        .header.w = CANVAS_SIZE,
+        .header.h = CANVAS_SIZE,
+        .data_size = sizeof(ab_copy),
+        .header.cf = LV_IMG_CF_TRUE_COLOR,
+        .data = (void *)ab_copy,
+    };
+    lv_canvas_fill_bg(ab_lvgl_canvas, LVGL_BACKGROUND, LV_OPA_COVER);
+    lv_canvas_transform(ab_lvgl_canvas, &img, 900, LV_IMG_ZOOM_NONE, -1, 0, CANVAS_SIZE / 2,
+                        CANVAS_SIZE / 2, true);
+}
+
+static void rotate_packed(void *data) {
+    ARG_UNUSED(data);
+    pack_1bpp(scratch_canvas_buf(), ab_packed);
+    rotate_1bpp(ab_packed, ab_1bpp);
+}
+
+void render_bench_rotate_ab(const char *name, render_bench_fn draw, void *data) {
+    const uint32_t frames = CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES;
+    struct bench_timing lvgl;
+    struct bench_timing packed;
+    uint32_t diff_bytes = 0;
+
+    if (ab_lvgl_canvas == NULL) {
+        ab_lvgl_canvas = lv_canvas_create(lv_layer_sys());
+        lv_obj_add_flag(ab_lvgl_canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_canvas_set_buffer(ab_lvgl_canvas, ab_lvgl_buf, CANVAS_SIZE, CANVAS_SIZE,
+                             LV_IMG_CF_TRUE_COLOR);
+    }
+    // Leaves a real frame in the scratch canvas
+    draw(data);
+
+    bench_time(&lvgl, frames, rotate_lvgl, NULL);
+    bench_time(&packed, frames, rotate_packed, NULL);
+
+    // Same packing for the LVGL result, then compare byte for byte
+    pack_1bpp(ab_lvgl_buf, ab_packed);
+    for (size_t i = 0; i < sizeof(ab_packed); i++) {
+        diff_bytes += ab_packed[i] != ab_1bpp[i];
+    }
+    if (diff_bytes > 0) {
+        LOG_WRN("rotate_1bpp differs from lv_canvas_transform in %u of %u bytes", diff_bytes,
+                (uint32_t)sizeof(ab_packed));
+    }
+
+    LOG_INF("nvbench {\"case\":\"%s\",\"backend\":\"%s\",\"layout\":\"%s\",\"frames\":%u,"
+            BENCH_TIMING_FMT ",\"cyc_lvgl\":%u,\"diff_bytes\":%u}",
+            name, BENCH_BACKEND, BENCH_LAYOUT, frames, BENCH_TIMING_ARGS(&packed, frames),
+            timing_cyc_avg(&lvgl, frames), diff_bytes);
+}
+#endif
+
+// Pixels LVGL will redraw on its next refresh; areas inside others were
+// never added, areas joined into others are skipped
+static uint32_t invalidated_px(const lv_disp_t *disp) {
+    uint32_t px = 0;
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            px += lv_area_get_size(&disp->inv_areas[i]);
+        }
+    }
+    return px;
+}
+
+void render_bench_refresh(const char *name, render_bench_fn fn, void *data) {
+    const uint32_t frames = CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_REFRESH_FRAMES;
+    lv_disp_t *disp = lv_disp_get_default();
+    uint64_t total_px = 0;
+    struct bench_timing timing = {.min_cyc = UINT32_MAX};
+
+    if (disp == NULL) {
+        return;
+    }
+    // Flush whatever is pending so only fn's areas are counted
+    lv_refr_now(disp);
+
+    for (uint32_t i = 0; i < frames; i++) {
+        fn(data);
+        total_px += invalidated_px(disp);
+
+        uint32_t start = k_cycle_get_32();
+        lv_refr_now(disp);
+        timing_add(&timing, k_cycle_get_32() - start);
+    }
+
+    LOG_INF("nvbench {\"case\":\"%s\",\"backend\":\"%s\",\"layout\":\"%s\",\"frames\":%u,"
+            BENCH_TIMING_FMT ",\"inv_px\":%u}",
+            name, BENCH_BACKEND, BENCH_LAYOUT, frames, BENCH_TIMING_ARGS(&timing, frames),
+            (uint32_t)(total_px / frames));
+}
@@ -0,0 +1,25 @@
+/*
+ * Custom Nice!View render benchmark
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+typedef void (*render_bench_fn)(void *data);
+
+// Call fn CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES times and log the
+// per-frame timing and LVGL pool usage as one JSON line tagged "nvbench"
+void render_bench_run(const char *name, render_bench_fn fn, void *data);
+
+// Call fn CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_REFRESH_FRAMES times, each
+// followed by an immediate LVGL refresh, and log the area each update
+// invalidated and the refresh time (drawing and flushing it) the same way
+void render_bench_refresh(const char *name, render_bench_fn fn, void *data);
+
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1) && !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+// Call draw once, then rotate the scratch canvas it left behind both with
+// rotate_1bpp (as region_draw_end does) and with lv_canvas_transform (as it
+// did before), CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH_FRAMES times each. Logs
+// both timings and how many bytes of the two packed results differ.
+void render_bench_rotate_ab(const char *name, render_bench_fn draw, void *data);
+#endif
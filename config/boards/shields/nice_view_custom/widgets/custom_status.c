@@ -1,6 +1,6 @@
 /*
  * Custom Nice!View Status Widget - Central
- * Battery %, modifiers, WPM graph, layer
+ * Top bar, modifiers, WPM graph, layer
  * SPDX-License-Identifier: MIT
  */
 
@@ -8,12 +8,10 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-#include <zmk/battery.h>
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
-#include <zmk/events/battery_state_changed.h>
-#include <zmk/events/usb_conn_state_changed.h>
-#include <zmk/usb.h>
+#include <zmk/activity.h>
+#include <zmk/events/activity_state_changed.h>
 
 #include <zmk/events/layer_state_changed.h>
 #include <zmk/events/keycode_state_changed.h>
@@ -22,98 +20,49 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/wpm.h>
 #include <zmk/events/wpm_state_changed.h>
 #include <dt-bindings/zmk/modifiers.h>
-#include <zmk/ble.h>
-#include <zmk/endpoints.h>
-#include <zmk/events/ble_active_profile_changed.h>
-#include <zmk/events/endpoint_changed.h>
 
 #include "util.h"
+#include "latency.h"
+#include "queue_stats.h"
 #include "custom_status.h"
-
-LV_IMG_DECLARE(bolt);
+#include "layer_labels.h"
+#include "scratch.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+#include "fb.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+#include "bench.h"
+#endif
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
-// TOP: Battery with % inside | Connection status
-static void draw_top(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-    lv_obj_t *canvas = lv_obj_get_child(widget, 0);
-
-    lv_draw_rect_dsc_t rect_black_dsc;
-    init_rect_dsc(&rect_black_dsc, LVGL_BACKGROUND);
-    lv_draw_rect_dsc_t rect_white_dsc;
-    init_rect_dsc(&rect_white_dsc, LVGL_FOREGROUND);
-    lv_draw_label_dsc_t label_dsc;
-    init_label_dsc(&label_dsc, LVGL_FOREGROUND, &lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER);
-    lv_draw_label_dsc_t label_dsc_right;
-    init_label_dsc(&label_dsc_right, LVGL_FOREGROUND, &lv_font_montserrat_16, LV_TEXT_ALIGN_RIGHT);
-
-    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_SIZE, CANVAS_SIZE, &rect_black_dsc);
-
-    // Connection status (top right, draw first so battery can overlap if needed)
-    char conn_text[10] = {};
-    switch (state->selected_endpoint.transport) {
-    case ZMK_TRANSPORT_USB:
-        strcat(conn_text, LV_SYMBOL_USB);
-        break;
-    case ZMK_TRANSPORT_BLE:
-        if (state->active_profile_bonded) {
-            if (state->active_profile_connected) {
-                snprintf(conn_text, sizeof(conn_text), LV_SYMBOL_WIFI " %d",
-                         state->active_profile_index + 1);
-            } else {
-                snprintf(conn_text, sizeof(conn_text), LV_SYMBOL_CLOSE " %d",
-                         state->active_profile_index + 1);
-            }
-        } else {
-            strcat(conn_text, LV_SYMBOL_SETTINGS);
-        }
-        break;
-    }
-    lv_canvas_draw_text(canvas, 40, 0, CANVAS_SIZE - 42, &label_dsc_right, conn_text);
-
-    // Battery outline with fill level
-    lv_canvas_draw_rect(canvas, 0, 2, 29, 12, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 1, 3, 27, 10, &rect_black_dsc);
-    lv_canvas_draw_rect(canvas, 2, 4, (state->battery * 25) / 100, 8, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 29, 4, 3, 6, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 30, 5, 1, 4, &rect_black_dsc);
-
-    // Battery percentage text inside
-    char bat_text[5];
-    snprintf(bat_text, sizeof(bat_text), "%d", state->battery);
-    lv_canvas_draw_text(canvas, 0, 0, 29, &label_dsc, bat_text);
-
-    // Charging bolt
-    if (state->charging) {
-        lv_draw_img_dsc_t img_dsc;
-        lv_draw_img_dsc_init(&img_dsc);
-        lv_canvas_draw_img(canvas, 9, -1, &bolt, &img_dsc);
-    }
-
-    rotate_canvas(canvas, cbuf);
-}
+// Plot area inside the WPM graph box
+#define WPM_GRAPH_X 2
+#define WPM_GRAPH_W 64
+#define WPM_GRAPH_Y_BOTTOM 63
+#define WPM_GRAPH_H 36
+
+// Only the bottom region's logical rows 0 .. 23 are on screen, in the
+// columns left of the middle region; the label is centered in them
+#define BOTTOM_ROWS 24
+#define LAYER_LABEL_FONT WIDGET_FONT_18
+#define LAYER_LABEL_Y ((BOTTOM_ROWS - LAYER_LABEL_FONT->line_height) / 2)
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+// Screen columns where each region's window starts; the portrait layout runs
+// right to left
+#define LAYOUT_TOP_X 92
+#define LAYOUT_MIDDLE_X 24
+#define LAYOUT_BOTTOM_X 0
+#endif
 
 // MIDDLE: Modifiers + WPM graph
-static void draw_middle(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-    lv_obj_t *canvas = lv_obj_get_child(widget, 1);
-
-    lv_draw_rect_dsc_t rect_black_dsc;
-    init_rect_dsc(&rect_black_dsc, LVGL_BACKGROUND);
-    lv_draw_rect_dsc_t rect_white_dsc;
-    init_rect_dsc(&rect_white_dsc, LVGL_FOREGROUND);
-    lv_draw_label_dsc_t label_dsc;
-    init_label_dsc(&label_dsc, LVGL_FOREGROUND, &lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER);
-    lv_draw_label_dsc_t label_dsc_inv;
-    init_label_dsc(&label_dsc_inv, LVGL_BACKGROUND, &lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER);
-    lv_draw_label_dsc_t label_dsc_wpm;
-    init_label_dsc(&label_dsc_wpm, LVGL_FOREGROUND, &lv_font_montserrat_14, LV_TEXT_ALIGN_RIGHT);
-    lv_draw_line_dsc_t line_dsc;
-    init_line_dsc(&line_dsc, LVGL_FOREGROUND, 2);
-
-    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_SIZE, CANVAS_SIZE, &rect_black_dsc);
+static void draw_mods(const struct region_draw *draw, zmk_mod_flags_t mods) {
+    const lv_draw_label_dsc_t *label_dsc =
+        get_label_dsc(WIDGET_FONT_14, LVGL_FOREGROUND, LV_TEXT_ALIGN_CENTER);
+    const lv_draw_label_dsc_t *label_dsc_inv =
+        get_label_dsc(WIDGET_FONT_14, LVGL_BACKGROUND, LV_TEXT_ALIGN_CENTER);
 
-    // Modifier indicators at top
-    zmk_mod_flags_t mods = zmk_hid_get_explicit_mods();
     bool mod_ctrl = (mods & (MOD_LCTL | MOD_RCTL)) != 0;
     bool mod_alt = (mods & (MOD_LALT | MOD_RALT)) != 0;
     bool mod_gui = (mods & (MOD_LGUI | MOD_RGUI)) != 0;
@@ -131,163 +80,251 @@ static void draw_middle(lv_obj_t *widget, lv_color_t cbuf[], const struct status
     for (int i = 0; i < 4; i++) {
         int x = start_x + i * (box_w + gap);
         if (mod_states[i]) {
-            lv_canvas_draw_rect(canvas, x, y, box_w, 18, &rect_white_dsc);
-            lv_canvas_draw_text(canvas, x, y + 1, box_w, &label_dsc_inv, mod_labels[i]);
+            region_fill_rect(draw, x, y, box_w, 18, LVGL_FOREGROUND);
+            region_draw_text(draw, x, y + 1, box_w, label_dsc_inv, mod_labels[i]);
         } else {
-            lv_canvas_draw_text(canvas, x, y + 1, box_w, &label_dsc, mod_labels[i]);
+            region_draw_text(draw, x, y + 1, box_w, label_dsc, mod_labels[i]);
         }
     }
+}
 
-    // WPM graph box
-    lv_canvas_draw_rect(canvas, 0, 24, 68, 42, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 1, 25, 66, 40, &rect_black_dsc);
+static void draw_wpm_number(const struct region_draw *draw, const struct status_state *state) {
+    const lv_draw_label_dsc_t *label_dsc_wpm =
+        get_label_dsc(WIDGET_FONT_14, LVGL_FOREGROUND, LV_TEXT_ALIGN_RIGHT);
 
-    // Current WPM number
     char wpm_text[6];
-    snprintf(wpm_text, sizeof(wpm_text), "%d", state->wpm[9]);
-    lv_canvas_draw_text(canvas, 42, 54, 24, &label_dsc_wpm, wpm_text);
-
-    // WPM graph line
-    int max = 0;
-    int min = 256;
-    for (int i = 0; i < 10; i++) {
-        if (state->wpm[i] > max) max = state->wpm[i];
-        if (state->wpm[i] < min) min = state->wpm[i];
-    }
-    int range = max - min;
-    if (range == 0) range = 1;
+    snprintf(wpm_text, sizeof(wpm_text), "%d", wpm_history_latest(&state->wpm));
+    region_draw_text(draw, 42, 54, 24, label_dsc_wpm, wpm_text);
+}
 
-    lv_point_t points[10];
-    for (int i = 0; i < 10; i++) {
-        points[i].x = 2 + i * 7;
-        points[i].y = 63 - (state->wpm[i] - min) * 36 / range;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+static void draw_middle(struct zmk_widget_custom_status *widget,
+                        const struct status_state *state) {
+    struct region_draw draw;
+    region_draw_begin(&draw, &widget->region_middle);
+
+    // A WPM sample leaves the mod strip and graph box alone; only the graph
+    // interior, which scrolls in its own buffer, and the number are redrawn
+    if (!wpm_graph_drawn(&widget->graph) || widget->drawn_mods != state->mods) {
+        region_fill_rect(&draw, 0, 0, CANVAS_SIZE, CANVAS_SIZE, LVGL_BACKGROUND);
+        draw_mods(&draw, state->mods);
+        region_fill_rect(&draw, 0, 24, 68, 42, LVGL_FOREGROUND);
+        widget->drawn_mods = state->mods;
     }
 
-    lv_canvas_draw_line(canvas, points, 10, &line_dsc);
+    wpm_graph_update(&widget->graph, &state->wpm);
+    fb_copy_rect(&draw.fb, &widget->graph.fb, 1, 25, 66, 40);
+    draw_wpm_number(&draw, state);
 
-    rotate_canvas(canvas, cbuf);
+    region_draw_end(&draw);
 }
+#else
+static void draw_middle(struct zmk_widget_custom_status *widget,
+                        const struct status_state *state) {
+    struct region_draw draw;
+    region_draw_begin(&draw, &widget->region_middle);
 
-// BOTTOM: Layer name
-static void draw_bottom(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-    lv_obj_t *canvas = lv_obj_get_child(widget, 2);
+    const lv_draw_line_dsc_t *line_dsc = get_line_dsc(LVGL_FOREGROUND, 2);
 
-    lv_draw_rect_dsc_t rect_black_dsc;
-    init_rect_dsc(&rect_black_dsc, LVGL_BACKGROUND);
-    lv_draw_label_dsc_t label_dsc;
-    init_label_dsc(&label_dsc, LVGL_FOREGROUND, &lv_font_montserrat_18, LV_TEXT_ALIGN_CENTER);
+    region_fill_rect(&draw, 0, 0, CANVAS_SIZE, CANVAS_SIZE, LVGL_BACKGROUND);
 
-    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_SIZE, CANVAS_SIZE, &rect_black_dsc);
+    // Modifier indicators at top
+    draw_mods(&draw, state->mods);
 
-    if (state->layer_label == NULL || strlen(state->layer_label) == 0) {
-        char text[12];
-        snprintf(text, sizeof(text), "LAYER %i", state->layer_index);
-        lv_canvas_draw_text(canvas, 0, 24, CANVAS_SIZE, &label_dsc, text);
-    } else {
-        lv_canvas_draw_text(canvas, 0, 24, CANVAS_SIZE, &label_dsc, state->layer_label);
+    // WPM graph box
+    region_fill_rect(&draw, 0, 24, 68, 42, LVGL_FOREGROUND);
+    region_fill_rect(&draw, 1, 25, 66, 40, LVGL_BACKGROUND);
+
+    // Current WPM number
+    draw_wpm_number(&draw, state);
+
+    // WPM graph line, one column per pixel at most
+    lv_point_t *points = scratch_alloc(WPM_HISTORY_MAX_POINTS(WPM_GRAPH_W) * sizeof(lv_point_t));
+    int count = points == NULL ? 0
+                               : wpm_history_decimate(&state->wpm, points, WPM_GRAPH_X,
+                                                      WPM_GRAPH_W, WPM_GRAPH_Y_BOTTOM,
+                                                      WPM_GRAPH_H);
+    if (count > 1) {
+        region_draw_line(&draw, points, count, line_dsc);
     }
 
-    rotate_canvas(canvas, cbuf);
+    region_draw_end(&draw);
 }
-
-// Event handlers
-static void set_battery_status(struct zmk_widget_custom_status *widget,
-                               struct battery_status_state state) {
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-    widget->state.charging = state.usb_present;
 #endif
-    widget->state.battery = state.level;
-    draw_top(widget->obj, widget->cbuf, &widget->state);
+
+// BOTTOM: Layer name
+static void draw_bottom(struct zmk_widget_custom_status *widget,
+                        const struct status_state *state) {
+    struct region_draw draw;
+    region_draw_begin(&draw, &widget->region_bottom);
+
+    const lv_draw_label_dsc_t *label_dsc =
+        get_label_dsc(LAYER_LABEL_FONT, LVGL_FOREGROUND, LV_TEXT_ALIGN_LEFT);
+
+    region_fill_rect(&draw, 0, 0, CANVAS_SIZE, CANVAS_SIZE, LVGL_BACKGROUND);
+
+    // Centered from the width measured with the table, so nothing is
+    // measured here. A name wider than the canvas starts at its left edge.
+    const struct layer_label *label = layer_labels_get(state->layer_index);
+    lv_coord_t width = MIN(label->width, CANVAS_SIZE);
+    lv_coord_t x = MAX((CANVAS_SIZE - width) / 2, 0);
+    region_draw_text(&draw, x, LAYER_LABEL_Y, CANVAS_SIZE - x, label_dsc, label->text);
+
+    region_draw_end(&draw);
 }
 
-static void battery_status_update_cb(struct battery_status_state state) {
-    struct zmk_widget_custom_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_battery_status(widget, state);
+static void draw_region(struct zmk_widget_custom_status *widget,
+                        const struct status_state *state, uint8_t region) {
+    switch (region) {
+    case STATUS_REGION_TOP:
+        top_bar_draw(&widget->top, state);
+        break;
+    case STATUS_REGION_MIDDLE:
+        draw_middle(widget, state);
+        break;
+    case STATUS_REGION_BOTTOM:
+        draw_bottom(widget, state);
+        break;
     }
 }
 
-static struct battery_status_state battery_status_get_state(const zmk_event_t *eh) {
-    return (struct battery_status_state){
-        .level = zmk_battery_state_of_charge(),
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-        .usb_present = zmk_usb_is_powered(),
-#endif
-    };
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+// Hand the dirty regions to the render thread along with a copy of their
+// inputs, so listeners can keep updating the state meanwhile. While a frame
+// is in flight the regions stay dirty and are requested again once it has
+// been published.
+static void draw_dirty(struct zmk_widget_custom_status *widget) {
+    render_pipe_start(&widget->pipe);
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_battery_status, struct battery_status_state,
-                            battery_status_update_cb, battery_status_get_state)
-ZMK_SUBSCRIPTION(widget_battery_status, zmk_battery_state_changed);
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-ZMK_SUBSCRIPTION(widget_battery_status, zmk_usb_conn_state_changed);
+static bool take_frame(struct render_pipe *pipe) {
+    struct zmk_widget_custom_status *widget =
+        CONTAINER_OF(pipe, struct zmk_widget_custom_status, pipe);
+    // Regions still waiting for their init stage keep their dirty bit
+    uint8_t dirty = widget->state.dirty & widget->state.ready;
+    if (dirty == 0) {
+        return false;
+    }
+    widget->state.dirty &= ~dirty;
+    widget->frame = widget->state;
+    widget->frame.dirty = dirty;
+    // The label table is only written here, while the render thread is idle
+    if (dirty & STATUS_REGION_BOTTOM) {
+        layer_labels_refresh(widget->frame.layer_index);
+    }
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    if (dirty & STATUS_REGION_MIDDLE) {
+        widget->wpm_drawn_total = widget->frame.wpm.total;
+    }
 #endif
 
-struct output_status_state {
-    struct zmk_endpoint_instance selected_endpoint;
-    int active_profile_index;
-    bool active_profile_connected;
-    bool active_profile_bonded;
-};
-
-static void set_output_status(struct zmk_widget_custom_status *widget,
-                              const struct output_status_state *state) {
-    widget->state.selected_endpoint = state->selected_endpoint;
-    widget->state.active_profile_index = state->active_profile_index;
-    widget->state.active_profile_connected = state->active_profile_connected;
-    widget->state.active_profile_bonded = state->active_profile_bonded;
-    draw_top(widget->obj, widget->cbuf, &widget->state);
+    // Latency stays on the display queue: rendering runs from here until
+    // the frame is published
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (dirty & BIT(i)) {
+            latency_render_start(BIT(i));
+        }
+    }
+    return true;
 }
 
-static void output_status_update_cb(struct output_status_state state) {
-    struct zmk_widget_custom_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_output_status(widget, &state);
+static void draw_frame(struct render_pipe *pipe) {
+    struct zmk_widget_custom_status *widget =
+        CONTAINER_OF(pipe, struct zmk_widget_custom_status, pipe);
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (widget->frame.dirty & BIT(i)) {
+            draw_region(widget, &widget->frame, BIT(i));
+        }
     }
 }
 
-static struct output_status_state output_status_get_state(const zmk_event_t *_eh) {
-    return (struct output_status_state){
-        .selected_endpoint = zmk_endpoints_selected(),
-        .active_profile_index = zmk_ble_active_profile_index(),
-        .active_profile_connected = zmk_ble_active_profile_is_connected(),
-        .active_profile_bonded = !zmk_ble_active_profile_is_open(),
-    };
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+static void run_bench(struct zmk_widget_custom_status *widget);
+#endif
+
+static void publish_frame(struct render_pipe *pipe) {
+    struct zmk_widget_custom_status *widget =
+        CONTAINER_OF(pipe, struct zmk_widget_custom_status, pipe);
+
+    screen_canvas_publish(&widget->screen);
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (widget->frame.dirty & BIT(i)) {
+            latency_render_end(BIT(i));
+        }
+    }
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+    // The render thread is idle until this returns
+    if (widget->bench_pending) {
+        widget->bench_pending = false;
+        run_bench(widget);
+    }
+#endif
+    if (widget->state.dirty & widget->state.ready) {
+        render_sched_request(&widget->sched);
+    }
 }
+#else
+// Redraw only the regions whose inputs changed
+static void draw_dirty(struct zmk_widget_custom_status *widget) {
+    // Regions still waiting for their init stage keep their dirty bit
+    uint8_t dirty = widget->state.dirty & widget->state.ready;
+    widget->state.dirty &= ~dirty;
+    if (dirty & STATUS_REGION_BOTTOM) {
+        layer_labels_refresh(widget->state.layer_index);
+    }
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    if (dirty & STATUS_REGION_MIDDLE) {
+        widget->wpm_drawn_total = widget->state.wpm.total;
+    }
+#endif
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_output_status, struct output_status_state,
-                            output_status_update_cb, output_status_get_state)
-ZMK_SUBSCRIPTION(widget_output_status, zmk_endpoint_changed);
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (dirty & BIT(i)) {
+            latency_render_start(BIT(i));
+            draw_region(widget, &widget->state, BIT(i));
+            latency_render_end(BIT(i));
+        }
+    }
+}
 #endif
-ZMK_SUBSCRIPTION(widget_output_status, zmk_ble_active_profile_changed);
 
+static void render_frame(struct render_sched *sched) {
+    draw_dirty(CONTAINER_OF(sched, struct zmk_widget_custom_status, sched));
+}
+
+// Event handlers
 struct layer_status_state {
     uint8_t index;
-    const char *label;
 };
 
 static void set_layer_status(struct zmk_widget_custom_status *widget,
                              struct layer_status_state state) {
+    // ZMK raises no event when a layer is renamed, so a layer change also
+    // picks up a new name for the layer it lands on
+    if (widget->state.layer_index == state.index && !layer_labels_stale(state.index)) {
+        return;
+    }
     widget->state.layer_index = state.index;
-    widget->state.layer_label = state.label;
-    draw_bottom(widget->obj, widget->cbuf3, &widget->state);
+    widget->state.dirty |= STATUS_REGION_BOTTOM;
+    render_sched_request(&widget->sched);
 }
 
 static void layer_status_update_cb(struct layer_status_state state) {
+    queue_stats_run(QUEUE_LISTENER_LAYER);
     struct zmk_widget_custom_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
         set_layer_status(widget, state);
+        latency_update(STATUS_REGION_BOTTOM, widget->state.dirty);
     }
 }
 
 static struct layer_status_state layer_status_get_state(const zmk_event_t *eh) {
-    uint8_t index = zmk_keymap_highest_layer_active();
-    return (struct layer_status_state){
-        .index = index,
-        .label = zmk_keymap_layer_name(zmk_keymap_layer_index_to_id(index)),
-    };
+    if (eh != NULL) {
+        latency_event(STATUS_REGION_BOTTOM);
+        queue_stats_event(QUEUE_LISTENER_LAYER);
+    }
+    return (struct layer_status_state){.index = zmk_keymap_highest_layer_active()};
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_layer_status, struct layer_status_state,
@@ -300,21 +337,44 @@ struct wpm_status_state {
 
 static void set_wpm_status(struct zmk_widget_custom_status *widget,
                            struct wpm_status_state state) {
-    for (int i = 0; i < 9; i++) {
-        widget->state.wpm[i] = widget->state.wpm[i + 1];
+    // Pushing its own value into a flat history leaves the graph unchanged
+    if (wpm_history_min(&widget->state.wpm) == state.wpm &&
+        wpm_history_max(&widget->state.wpm) == state.wpm) {
+        return;
     }
-    widget->state.wpm[9] = state.wpm;
-    draw_middle(widget->obj, widget->cbuf2, &widget->state);
+
+    wpm_history_push(&widget->state.wpm, state.wpm);
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    // While idle, WPM only decays toward zero; keep sampling but leave the
+    // graph on screen frozen until activity resumes
+    if (widget->sched.idle) {
+        render_sched_suppress(&widget->sched);
+        return;
+    }
+#endif
+
+    widget->state.dirty |= STATUS_REGION_MIDDLE;
+    render_sched_request(&widget->sched);
 }
 
 static void wpm_status_update_cb(struct wpm_status_state state) {
+    queue_stats_run(QUEUE_LISTENER_WPM);
     struct zmk_widget_custom_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
         set_wpm_status(widget, state);
+        latency_update(STATUS_REGION_MIDDLE, widget->state.dirty);
     }
 }
 
 static struct wpm_status_state wpm_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_wpm_state_changed *ev = eh != NULL ? as_zmk_wpm_state_changed(eh) : NULL;
+    if (ev != NULL) {
+        latency_event(STATUS_REGION_MIDDLE);
+        queue_stats_event(QUEUE_LISTENER_WPM);
+        // The sample the event carries, so replayed events are drawn as sent
+        return (struct wpm_status_state){.wpm = ev->state};
+    }
     return (struct wpm_status_state){.wpm = zmk_wpm_get_state()};
 }
 
@@ -327,57 +387,275 @@ struct keycode_state {
     bool pressed;
 };
 
+static void set_mods_status(struct zmk_widget_custom_status *widget, zmk_mod_flags_t mods) {
+    if (widget->state.mods == mods) {
+        return;
+    }
+    widget->state.mods = mods;
+    widget->state.dirty |= STATUS_REGION_MIDDLE;
+    render_sched_request(&widget->sched);
+}
+
 static void keycode_update_cb(struct keycode_state state) {
+    queue_stats_run(QUEUE_LISTENER_KEYCODE);
+    // Read mods here rather than in keycode_get_state, so the HID report has
+    // already been updated for this keycode event
+    zmk_mod_flags_t mods = zmk_hid_get_explicit_mods();
     struct zmk_widget_custom_status *widget;
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        draw_middle(widget->obj, widget->cbuf2, &widget->state);
+        set_mods_status(widget, mods);
+        latency_update(STATUS_REGION_MIDDLE, widget->state.dirty);
     }
 }
 
 static struct keycode_state keycode_get_state(const zmk_event_t *eh) {
-    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
-    return (struct keycode_state){.pressed = ev->state};
+    const struct zmk_keycode_state_changed *ev =
+        eh != NULL ? as_zmk_keycode_state_changed(eh) : NULL;
+    if (ev != NULL) {
+        latency_event(STATUS_REGION_MIDDLE);
+        queue_stats_event(QUEUE_LISTENER_KEYCODE);
+    }
+    return (struct keycode_state){.pressed = ev != NULL && ev->state};
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_keycode, struct keycode_state,
                             keycode_update_cb, keycode_get_state)
 ZMK_SUBSCRIPTION(widget_keycode, zmk_keycode_state_changed);
 
-int zmk_widget_custom_status_init(struct zmk_widget_custom_status *widget, lv_obj_t *parent) {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 160, 68);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+struct activity_status_state {
+    enum zmk_activity_state state;
+};
+
+static void activity_update_cb(struct activity_status_state state) {
+    struct zmk_widget_custom_status *widget;
+    queue_stats_run(QUEUE_LISTENER_ACTIVITY);
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        bool idle = state.state != ZMK_ACTIVITY_ACTIVE;
+        // Samples taken while idle are drawn in the catch-up frame. The graph
+        // is only redrawn if the history moved past the one on screen.
+        if (!idle && widget->state.wpm.total != widget->wpm_drawn_total &&
+            !(widget->state.dirty & STATUS_REGION_MIDDLE)) {
+            widget->state.dirty |= STATUS_REGION_MIDDLE;
+            render_sched_request(&widget->sched);
+        }
+        render_sched_set_idle(&widget->sched, idle);
+    }
+}
+
+static struct activity_status_state activity_get_state(const zmk_event_t *eh) {
+    if (eh != NULL) {
+        queue_stats_event(QUEUE_LISTENER_ACTIVITY);
+    }
+    return (struct activity_status_state){.state = zmk_activity_get_state()};
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_activity, struct activity_status_state, activity_update_cb,
+                            activity_get_state)
+ZMK_SUBSCRIPTION(widget_activity, zmk_activity_state_changed);
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+// The bench draws on the display queue while the render thread is idle, and
+// publishes each frame itself, so the render cases include the swap
+static void bench_publish(struct zmk_widget_custom_status *widget) {
+    screen_canvas_publish(&widget->screen);
+}
+#else
+static void bench_publish(struct zmk_widget_custom_status *widget) { ARG_UNUSED(widget); }
+#endif
+
+static void bench_top(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+    top_bar_draw(&widget->top, &widget->state);
+    bench_publish(widget);
+}
+
+static void bench_middle(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+    // Vary the inputs so every frame draws a different graph and mod strip
+    widget->state.mods++;
+    wpm_history_push(&widget->state.wpm, widget->state.mods * 37);
+    draw_middle(widget, &widget->state);
+    bench_publish(widget);
+}
+
+static void bench_wpm(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+    static uint32_t n;
+    // A WPM sample alone, in a range that keeps the graph scale fixed
+    n++;
+    wpm_history_push(&widget->state.wpm, n % 2 ? 100 : (n % 4 == 0 ? 0 : (n * 13) % 50));
+    draw_middle(widget, &widget->state);
+    bench_publish(widget);
+}
+
+static void bench_bottom(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+    draw_bottom(widget, &widget->state);
+    bench_publish(widget);
+}
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+static void bench_rotate(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+    struct region_draw draw;
+    region_draw_begin(&draw, &widget->region_top);
+    region_draw_end(&draw);
+}
+#endif
+
+static void run_bench(struct zmk_widget_custom_status *widget) {
+    struct status_state saved = widget->state;
+
+    render_bench_run("top", bench_top, widget);
+    render_bench_run("middle", bench_middle, widget);
+    render_bench_run("wpm", bench_wpm, widget);
+    render_bench_run("bottom", bench_bottom, widget);
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+    render_bench_run("rotate", bench_rotate, widget);
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+    render_bench_rotate_ab("rotate_ab", bench_top, widget);
+#endif
+#endif
+    render_bench_refresh("refresh_top", bench_top, widget);
+    render_bench_refresh("refresh_middle", bench_middle, widget);
+    render_bench_refresh("refresh_bottom", bench_bottom, widget);
+
+    widget->state = saved;
+    widget->state.dirty = STATUS_REGION_ALL;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+    wpm_graph_invalidate(&widget->graph);
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    render_sched_request(&widget->sched);
+#endif
+}
+#endif
 
+// Init stages: layout and placeholders first, then each region as its data
+// sources are queried and its listeners set up
+
+static void init_layout(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+    screen_canvas_region(&widget->screen, &widget->region_top, LAYOUT_TOP_X, 0, CANVAS_SIZE);
+    screen_canvas_region(&widget->screen, &widget->region_middle, LAYOUT_MIDDLE_X, 0,
+                         CANVAS_SIZE);
+    screen_canvas_region(&widget->screen, &widget->region_bottom, LAYOUT_BOTTOM_X, 0,
+                         BOTTOM_ROWS);
+#else
     lv_obj_t *top = lv_canvas_create(widget->obj);
     lv_obj_align(top, LV_ALIGN_TOP_RIGHT, 0, 0);
-    lv_canvas_set_buffer(top, widget->cbuf, CANVAS_SIZE, CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR);
+    region_init_canvas(&widget->region_top, top, widget->cbuf);
 
     lv_obj_t *middle = lv_canvas_create(widget->obj);
     lv_obj_align(middle, LV_ALIGN_TOP_LEFT, 24, 0);
-    lv_canvas_set_buffer(middle, widget->cbuf2, CANVAS_SIZE, CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR);
+    region_init_canvas(&widget->region_middle, middle, widget->cbuf2);
 
+    // Row y sits at canvas column 67 - y, so rows 0 .. BOTTOM_ROWS - 1 are
+    // the columns that land on screen
     lv_obj_t *bottom = lv_canvas_create(widget->obj);
-    lv_obj_align(bottom, LV_ALIGN_TOP_LEFT, -44, 0);
-    lv_canvas_set_buffer(bottom, widget->cbuf3, CANVAS_SIZE, CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_align(bottom, LV_ALIGN_TOP_LEFT, BOTTOM_ROWS - CANVAS_SIZE, 0);
+    region_init_canvas(&widget->region_bottom, bottom, widget->cbuf3);
+#endif
+
+    draw_placeholder(&widget->region_top);
+    draw_placeholder(&widget->region_middle);
+    draw_placeholder(&widget->region_bottom);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    // Nothing is in flight yet, so the placeholders go out from here
+    screen_canvas_publish(&widget->screen);
+    render_pipe_init(&widget->pipe, take_frame, draw_frame, publish_frame);
+#endif
 
+    widget->state.dirty = 0;
+    widget->state.ready = 0;
+    render_sched_init(&widget->sched, render_frame);
     sys_slist_append(&widgets, &widget->node);
+}
 
-    widget->state.battery = zmk_battery_state_of_charge();
-    widget->state.selected_endpoint = zmk_endpoints_selected();
-    widget->state.active_profile_index = zmk_ble_active_profile_index();
-    widget->state.active_profile_connected = zmk_ble_active_profile_is_connected();
-    widget->state.active_profile_bonded = !zmk_ble_active_profile_is_open();
-    widget->state.layer_index = zmk_keymap_highest_layer_active();
-    widget->state.layer_label = NULL;
+// Listener inits mark their region dirty and request a frame like any event.
+// The region's stage marks it ready and draws it straight away (or hands it
+// to the render thread), so the scheduled frame finds it clean; regions whose
+// stage hasn't run yet keep their dirty bit until it does.
+static void init_region(struct zmk_widget_custom_status *widget, uint8_t region) {
+    widget->state.ready |= region;
+    widget->state.dirty |= region;
+    draw_dirty(widget);
+}
 
-    widget_battery_status_init();
-    widget_output_status_init();
+static void init_top(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+
+    top_bar_init(&widget->top, &widget->region_top, &widget->state, &widget->sched);
+    init_region(widget, STATUS_REGION_TOP);
+}
+
+static void init_bottom(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+
+    layer_labels_init(LAYER_LABEL_FONT);
+    widget->state.layer_index = zmk_keymap_highest_layer_active();
     widget_layer_status_init();
+    init_region(widget, STATUS_REGION_BOTTOM);
+}
+
+static void init_middle(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+
+    widget->state.mods = zmk_hid_get_explicit_mods();
+    wpm_history_init(&widget->state.wpm);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+    wpm_graph_init(&widget->graph, WPM_GRAPH_X, WPM_GRAPH_W, WPM_GRAPH_Y_BOTTOM, WPM_GRAPH_H);
+#endif
     widget_wpm_status_init();
     widget_keycode_init();
+    init_region(widget, STATUS_REGION_MIDDLE);
+}
+
+static void init_finish(void *data) {
+    struct zmk_widget_custom_status *widget = data;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    widget_activity_init();
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH) && \
+    IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    // The bench draws into the back buffer, so it waits for a frame in flight
+    if (render_pipe_busy(&widget->pipe)) {
+        widget->bench_pending = true;
+    } else {
+        run_bench(widget);
+    }
+#elif IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+    run_bench(widget);
+    draw_dirty(widget);
+#else
+    ARG_UNUSED(widget);
+#endif
+}
+
+static const struct init_stage init_stages[] = {
+    {"layout", init_layout},
+    {"top", init_top},
+    {"bottom", init_bottom},
+    {"middle", init_middle},
+    {"finish", init_finish},
+};
+
+int zmk_widget_custom_status_init(struct zmk_widget_custom_status *widget, lv_obj_t *parent) {
+    draw_dsc_init();
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+    widget->obj = screen_canvas_init(&widget->screen, parent);
+#else
+    widget->obj = lv_obj_create(parent);
+    lv_obj_set_size(widget->obj, 160, 68);
+#endif
 
-    draw_top(widget->obj, widget->cbuf, &widget->state);
-    draw_middle(widget->obj, widget->cbuf2, &widget->state);
-    draw_bottom(widget->obj, widget->cbuf3, &widget->state);
+    staged_init_start(&widget->init, init_stages, ARRAY_SIZE(init_stages), widget);
 
     return 0;
 }
@@ -8,14 +8,56 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 #include "util.h"
+#include "render_sched.h"
+#include "staged_init.h"
+#include "top_bar.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+#include "screen_canvas.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+#include "wpm_graph.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+#include "render_pipe.h"
+#endif
 
 struct zmk_widget_custom_status {
     sys_snode_t node;
     lv_obj_t *obj;
-    lv_color_t cbuf[CANVAS_SIZE * CANVAS_SIZE];
-    lv_color_t cbuf2[CANVAS_SIZE * CANVAS_SIZE];
-    lv_color_t cbuf3[CANVAS_SIZE * CANVAS_SIZE];
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+    struct screen_canvas screen;
+#else
+    uint8_t cbuf[CANVAS_BUF_SIZE] __aligned(4);
+    uint8_t cbuf2[CANVAS_BUF_SIZE] __aligned(4);
+    uint8_t cbuf3[CANVAS_BUF_SIZE] __aligned(4);
+#endif
+    struct region region_top;
+    struct region region_middle;
+    struct region region_bottom;
     struct status_state state;
+    struct render_sched sched;
+    struct staged_init init;
+    struct top_bar top;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    // WPM samples pushed when the graph was last taken for drawing; the
+    // graph on screen is stale when the history has moved past it
+    uint32_t wpm_drawn_total;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_SCROLL)
+    struct wpm_graph graph;
+    // Mods shown in the middle region's strip, kept while only the graph changes
+    zmk_mod_flags_t drawn_mods;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    // Inputs of the frame on the render thread, copied when it was taken;
+    // dirty holds the regions it draws
+    struct status_state frame;
+    struct render_pipe pipe;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+    // The bench waits for the frame in flight to be published
+    bool bench_pending;
+#endif
+#endif
 };
 
 int zmk_widget_custom_status_init(struct zmk_widget_custom_status *widget, lv_obj_t *parent);
@@ -0,0 +1,58 @@
+/*
+ * Custom Nice!View widget event recorder
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+
+// One "nvrec" line per event the status widget listens to, in the stream
+// format host/replay_main.c reads, so a captured log replays on the host
+static int event_record_listener(const zmk_event_t *eh) {
+    int64_t now = k_uptime_get();
+
+    const struct zmk_keycode_state_changed *key = as_zmk_keycode_state_changed(eh);
+    if (key != NULL) {
+        LOG_INF("nvrec %lld key 0x%02x %s", now, key->keycode, key->state ? "down" : "up");
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_layer_state_changed *layer = as_zmk_layer_state_changed(eh);
+    if (layer != NULL) {
+        LOG_INF("nvrec %lld layer %u %s", now, layer->layer, layer->state ? "on" : "off");
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_wpm_state_changed *wpm = as_zmk_wpm_state_changed(eh);
+    if (wpm != NULL) {
+        LOG_INF("nvrec %lld wpm %d", now, wpm->state);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_battery_state_changed *battery = as_zmk_battery_state_changed(eh);
+    if (battery != NULL) {
+        LOG_INF("nvrec %lld battery %u", now, battery->state_of_charge);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_activity_state_changed *activity = as_zmk_activity_state_changed(eh);
+    if (activity != NULL) {
+        LOG_INF("nvrec %lld activity %d", now, activity->state);
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(nice_view_event_record, event_record_listener);
+ZMK_SUBSCRIPTION(nice_view_event_record, zmk_keycode_state_changed);
+ZMK_SUBSCRIPTION(nice_view_event_record, zmk_layer_state_changed);
+ZMK_SUBSCRIPTION(nice_view_event_record, zmk_wpm_state_changed);
+ZMK_SUBSCRIPTION(nice_view_event_record, zmk_battery_state_changed);
+ZMK_SUBSCRIPTION(nice_view_event_record, zmk_activity_state_changed);
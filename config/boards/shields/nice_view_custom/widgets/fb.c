@@ -0,0 +1,351 @@
+/*
+ * Custom Nice!View direct 1bpp framebuffer drawing
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "fb.h"
+#include "util.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+#include "text_cache.h"
+#endif
+
+// Logical (x, y) is stored at row x, column fb_col(fb, y)
+static inline int fb_col(const struct fb_view *fb, lv_coord_t y) {
+    return fb->col0 + CANVAS_SIZE - 1 - y;
+}
+
+static inline bool fb_clipped(const struct fb_view *fb, lv_coord_t x, lv_coord_t y) {
+    return x < 0 || x >= CANVAS_SIZE || y < fb->y0 || y >= fb->y1;
+}
+
+static inline void fb_px(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, bool ink) {
+    if (fb_clipped(fb, x, y)) {
+        return;
+    }
+    int col = fb_col(fb, y);
+    uint8_t *byte = &fb->buf[x * fb->stride + col / 8];
+    uint8_t mask = BIT(7 - col % 8);
+    *byte = ink ? (*byte | mask) : (*byte & ~mask);
+}
+
+static inline bool fb_get(const struct fb_view *fb, lv_coord_t x, lv_coord_t y) {
+    int col = fb_col(fb, y);
+    return !fb_clipped(fb, x, y) && (fb->buf[x * fb->stride + col / 8] & BIT(7 - col % 8));
+}
+
+static inline void fb_apply(uint8_t *byte, uint8_t mask, bool ink) {
+    *byte = ink ? (*byte | mask) : (*byte & ~mask);
+}
+
+// A logical rect is a run of whole rows x0 .. x1 - 1, each covering the
+// same column span: bytes b0 .. b1, with partial masks m0 and m1 at the ends
+struct fb_span {
+    lv_coord_t x0, x1;
+    int b0, b1;
+    uint8_t m0, m1;
+};
+
+static bool fb_rect_span(const struct fb_view *fb, struct fb_span *span, lv_coord_t x,
+                         lv_coord_t y, lv_coord_t w, lv_coord_t h) {
+    lv_coord_t y0 = MAX(y, fb->y0);
+    lv_coord_t y1 = MIN(y + h, fb->y1);
+    span->x0 = MAX(x, 0);
+    span->x1 = MIN(x + w, CANVAS_SIZE);
+    if (span->x0 >= span->x1 || y0 >= y1) {
+        return false;
+    }
+
+    int c0 = fb_col(fb, y1 - 1);
+    int c1 = fb_col(fb, y0);
+    span->b0 = c0 / 8;
+    span->b1 = c1 / 8;
+    span->m0 = 0xFF >> (c0 % 8);
+    span->m1 = 0xFF << (7 - c1 % 8);
+    return true;
+}
+
+void fb_fill_rect(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                  lv_coord_t h, bool ink) {
+    struct fb_span span;
+    if (!fb_rect_span(fb, &span, x, y, w, h)) {
+        return;
+    }
+
+    for (lv_coord_t row = span.x0; row < span.x1; row++) {
+        uint8_t *line = &fb->buf[row * fb->stride];
+        if (span.b0 == span.b1) {
+            fb_apply(&line[span.b0], span.m0 & span.m1, ink);
+            continue;
+        }
+        fb_apply(&line[span.b0], span.m0, ink);
+        if (span.b1 - span.b0 > 1) {
+            memset(&line[span.b0 + 1], ink ? 0xFF : 0x00, span.b1 - span.b0 - 1);
+        }
+        fb_apply(&line[span.b1], span.m1, ink);
+    }
+}
+
+static void fb_segment(const struct fb_view *fb, lv_point_t a, lv_point_t b, uint8_t width,
+                       bool ink) {
+    lv_coord_t dx = LV_ABS(b.x - a.x);
+    lv_coord_t dy = -LV_ABS(b.y - a.y);
+    lv_coord_t sx = a.x < b.x ? 1 : -1;
+    lv_coord_t sy = a.y < b.y ? 1 : -1;
+    lv_coord_t err = dx + dy;
+    lv_coord_t off = width / 2;
+
+    while (true) {
+        if (width <= 1) {
+            fb_px(fb, a.x, a.y, ink);
+        } else {
+            fb_fill_rect(fb, a.x - off, a.y - off, width, width, ink);
+        }
+        if (a.x == b.x && a.y == b.y) {
+            break;
+        }
+        lv_coord_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            a.x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            a.y += sy;
+        }
+    }
+}
+
+void fb_draw_line(const struct fb_view *fb, const lv_point_t *points, uint16_t count,
+                  uint8_t width, bool ink) {
+    for (int i = 1; i < count; i++) {
+        fb_segment(fb, points[i - 1], points[i], width, ink);
+    }
+}
+
+static uint8_t fb_bits(const uint8_t *data, uint8_t bpp, uint32_t index) {
+    uint32_t bit = index * bpp;
+    return (data[bit / 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1);
+}
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+static void fb_blit_sprite(const struct fb_view *fb, const struct text_sprite *sprite,
+                           lv_coord_t x0, lv_coord_t y, lv_coord_t clip_x0, lv_coord_t clip_x1,
+                           bool ink) {
+    lv_coord_t col_start = MAX(0, clip_x0 - x0);
+    lv_coord_t col_end = MIN(sprite->w, clip_x1 - x0);
+
+    for (int row = 0; row < sprite->h; row++) {
+        const uint8_t *bits = &sprite->bits[row * sprite->stride];
+        for (int col = col_start; col < col_end; col++) {
+            if (bits[col / 8] & BIT(7 - col % 8)) {
+                fb_px(fb, x0 + col, y + row, ink);
+            }
+        }
+    }
+}
+#endif
+
+static void fb_blit_glyphs(const struct fb_view *fb, const lv_font_t *font, const char *text,
+                           lv_coord_t x0, lv_coord_t y, lv_coord_t clip_x0, lv_coord_t clip_x1,
+                           bool ink) {
+    uint32_t i = 0;
+    lv_coord_t pen = x0;
+    uint32_t letter = _lv_txt_encoded_next(text, &i);
+
+    while (letter != 0) {
+        uint32_t next = _lv_txt_encoded_next(text, &i);
+        lv_font_glyph_dsc_t g;
+
+        if (lv_font_get_glyph_dsc(font, &g, letter, next)) {
+            const lv_font_t *glyph_font = g.resolved_font != NULL ? g.resolved_font : font;
+            const uint8_t *bitmap = lv_font_get_glyph_bitmap(glyph_font, letter);
+            uint8_t max = (1 << g.bpp) - 1;
+            lv_coord_t gx = pen + g.ofs_x;
+            lv_coord_t gy = y + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+
+            for (int row = 0; bitmap != NULL && row < g.box_h; row++) {
+                for (int col = 0; col < g.box_w; col++) {
+                    lv_coord_t px = gx + col;
+                    if (px < clip_x0 || px >= clip_x1) {
+                        continue;
+                    }
+                    if (fb_bits(bitmap, g.bpp, row * g.box_w + col) * 2 > max) {
+                        fb_px(fb, px, gy + row, ink);
+                    }
+                }
+            }
+            pen += g.adv_w;
+        }
+        letter = next;
+    }
+}
+
+void fb_draw_text(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                  const lv_font_t *font, lv_text_align_t align, bool ink, const char *text) {
+    lv_coord_t x0 = x;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+    const struct text_sprite *sprite = text_cache_get(font, text);
+#endif
+
+    // Left-aligned text needs no width, e.g. labels centered by the caller
+    if (align != LV_TEXT_ALIGN_LEFT) {
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+        lv_coord_t w = sprite != NULL
+                           ? sprite->w
+                           : lv_txt_get_width(text, strlen(text), font, 0, LV_TEXT_FLAG_NONE);
+#else
+        lv_coord_t w = lv_txt_get_width(text, strlen(text), font, 0, LV_TEXT_FLAG_NONE);
+#endif
+        x0 += align == LV_TEXT_ALIGN_CENTER ? (max_w - w) / 2 : max_w - w;
+    }
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+    if (sprite != NULL) {
+        fb_blit_sprite(fb, sprite, x0, y, x, x + max_w, ink);
+        return;
+    }
+#endif
+    fb_blit_glyphs(fb, font, text, x0, y, x, x + max_w, ink);
+}
+
+void fb_draw_img(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img) {
+    uint8_t bpp;
+    switch (img->header.cf) {
+    case LV_IMG_CF_INDEXED_1BIT:
+        bpp = 1;
+        break;
+    case LV_IMG_CF_INDEXED_2BIT:
+        bpp = 2;
+        break;
+    case LV_IMG_CF_INDEXED_4BIT:
+        bpp = 4;
+        break;
+    case LV_IMG_CF_INDEXED_8BIT:
+        bpp = 8;
+        break;
+    default:
+        return;
+    }
+
+    // Resolve the palette once: bit 0 = opaque, bit 1 = ink. At 1-bit color
+    // depth a color is white when any channel is at least 128.
+    uint8_t lut[256];
+    const lv_color32_t *palette = (const lv_color32_t *)img->data;
+    int colors = 1 << bpp;
+    for (int i = 0; i < colors; i++) {
+        bool opaque = palette[i].ch.alpha >= LV_OPA_50;
+        bool light = palette[i].ch.red >= 128 || palette[i].ch.green >= 128 ||
+                     palette[i].ch.blue >= 128;
+        lv_color_t color = light ? lv_color_white() : lv_color_black();
+        lut[i] = opaque | ((color.full != LVGL_BACKGROUND.full) << 1);
+    }
+
+    const uint8_t *pixels = img->data + colors * sizeof(lv_color32_t);
+    uint32_t stride = DIV_ROUND_UP(img->header.w * bpp, 8);
+    for (int row = 0; row < img->header.h; row++) {
+        const uint8_t *line = &pixels[row * stride];
+        for (int col = 0; col < img->header.w; col++) {
+            uint8_t px = lut[fb_bits(line, bpp, col)];
+            if (px & BIT(0)) {
+                fb_px(fb, x + col, y + row, px & BIT(1));
+            }
+        }
+    }
+}
+
+static inline void fb_merge(uint8_t *dst, uint8_t src, uint8_t mask) {
+    *dst = (*dst & ~mask) | (src & mask);
+}
+
+void fb_copy_rect(const struct fb_view *dst, const struct fb_view *src, lv_coord_t x,
+                  lv_coord_t y, lv_coord_t w, lv_coord_t h) {
+    // Only rows both views hold
+    lv_coord_t y0 = MAX(y, src->y0);
+    lv_coord_t y1 = MIN(y + h, src->y1);
+    struct fb_span span;
+    if (!fb_rect_span(dst, &span, x, y0, w, y1 - y0)) {
+        return;
+    }
+
+    int shift = dst->col0 - src->col0;
+    if (shift % 8 != 0) {
+        for (lv_coord_t row = span.x0; row < span.x1; row++) {
+            for (lv_coord_t py = MAX(y0, dst->y0); py < MIN(y1, dst->y1); py++) {
+                fb_px(dst, row, py, fb_get(src, row, py));
+            }
+        }
+        return;
+    }
+
+    int offset = shift / 8;
+    for (lv_coord_t row = span.x0; row < span.x1; row++) {
+        uint8_t *to = &dst->buf[row * dst->stride];
+        const uint8_t *from = &src->buf[row * src->stride];
+        int b0 = span.b0 - offset;
+        int b1 = span.b1 - offset;
+        if (span.b0 == span.b1) {
+            fb_merge(&to[span.b0], from[b0], span.m0 & span.m1);
+            continue;
+        }
+        fb_merge(&to[span.b0], from[b0], span.m0);
+        if (span.b1 - span.b0 > 1) {
+            memcpy(&to[span.b0 + 1], &from[b0 + 1], span.b1 - span.b0 - 1);
+        }
+        fb_merge(&to[span.b1], from[b1], span.m1);
+    }
+}
+
+// Bits of byte b that fall in columns lo .. hi
+static inline uint8_t fb_byte_mask(int b, int lo, int hi) {
+    int first = MAX(lo - b * 8, 0);
+    int last = MIN(hi - b * 8, 7);
+    if (first > last) {
+        return 0;
+    }
+    return (uint8_t)(0xFF >> first) & (uint8_t)(0xFF << (7 - last));
+}
+
+void fb_blit(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, const struct fb_sprite *sprite) {
+    // Sprite bit k lands in column c0 + k; split that into a byte and a shift,
+    // rounding down so sprites hanging off the top of the region still work
+    int c0 = fb_col(fb, y + sprite->h - 1);
+    int first = c0 >= 0 ? c0 / 8 : -((7 - c0) / 8);
+    int shift = c0 - first * 8;
+    // Columns of the view's rows; everything else is clipped
+    int lo = fb_col(fb, fb->y1 - 1);
+    int hi = fb_col(fb, fb->y0);
+
+    for (int r = 0; r < sprite->w; r++) {
+        lv_coord_t row = x + r;
+        if (row < 0 || row >= CANVAS_SIZE) {
+            continue;
+        }
+        uint8_t *line = &fb->buf[row * fb->stride];
+        const uint8_t *ink = &sprite->ink[r * sprite->stride];
+        const uint8_t *mask = &sprite->mask[r * sprite->stride];
+        for (int i = 0; i <= sprite->stride; i++) {
+            // Byte first + i takes the low bits of sprite byte i - 1 and the
+            // high bits of sprite byte i
+            int b = first + i;
+            uint8_t m = fb_byte_mask(b, lo, hi);
+            if (m == 0) {
+                continue;
+            }
+            uint8_t bits = 0;
+            uint8_t opaque = 0;
+            if (i < sprite->stride) {
+                bits |= ink[i] >> shift;
+                opaque |= mask[i] >> shift;
+            }
+            if (i > 0 && shift != 0) {
+                bits |= ink[i - 1] << (8 - shift);
+                opaque |= mask[i - 1] << (8 - shift);
+            }
+            fb_merge(&line[b], bits, opaque & m);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Custom Nice!View direct 1bpp framebuffer drawing
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <lvgl.h>
+
+#include "util.h"
+
+// Draw straight into a region's packed 1bpp pixels through a struct fb_view
+// (see util.h). Coordinates are the unrotated 68x68 ones the widgets draw in;
+// pixels land where rotate_1bpp would have put them, so there is no scratch
+// canvas and no rotation pass. `ink` selects foreground (true) or background
+// (false); everything is clipped to the view's rows.
+
+#define FB_STRIDE ((CANVAS_SIZE + 7) / 8)
+#define FB_SIZE (FB_STRIDE * CANVAS_SIZE)
+
+// A region's own pixel data, laid out like its 68x68 canvas
+static inline struct fb_view fb_view_region(uint8_t *buf) {
+    return (struct fb_view){.buf = buf, .stride = FB_STRIDE, .y0 = 0, .y1 = CANVAS_SIZE};
+}
+
+void fb_fill_rect(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                  lv_coord_t h, bool ink);
+
+// Bresenham polyline, each point stamped as a width x width square
+void fb_draw_line(const struct fb_view *fb, const lv_point_t *points, uint16_t count,
+                  uint8_t width, bool ink);
+
+// Text placed per align inside max_w and clipped to it, like text_cache_draw.
+// Glyph coverage above 50% is ink, matching LVGL at 1-bit color depth.
+void fb_draw_text(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                  const lv_font_t *font, lv_text_align_t align, bool ink, const char *text);
+
+// Indexed (1/2/4/8 bit) image; transparent palette entries leave pixels alone
+void fb_draw_img(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img);
+
+// A w x h bitmap already in region layout, generated by scripts/gen_assets.py:
+// row r holds logical column x + r, and bit k of a row (MSB first) is logical
+// row y + h - 1 - k. Ink bits are drawn where the mask is set.
+struct fb_sprite {
+    uint8_t w;
+    uint8_t h;
+    uint8_t stride;
+    const uint8_t *ink;
+    const uint8_t *mask;
+};
+
+// Each sprite row lands as one shifted run of bytes; no palette, no rotation
+void fb_blit(const struct fb_view *fb, lv_coord_t x, lv_coord_t y, const struct fb_sprite *sprite);
+
+// Copy a rect from another view, ink and background alike. Whole bytes are
+// copied when both views share a bit alignment, pixels otherwise.
+void fb_copy_rect(const struct fb_view *dst, const struct fb_view *src, lv_coord_t x,
+                  lv_coord_t y, lv_coord_t w, lv_coord_t h);
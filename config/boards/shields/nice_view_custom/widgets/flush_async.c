@@ -0,0 +1,109 @@
+/*
+ * Custom Nice!View asynchronous panel flush
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+
+#include "flush_async.h"
+#include "latency.h"
+#include "panel_flush.h"
+
+static K_THREAD_STACK_DEFINE(flush_stack,
+                             CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH_STACK_SIZE);
+static struct k_work_q flush_q;
+static struct k_work flush_work;
+// Given after every flush, once LVGL may reuse its buffer
+static K_SEM_DEFINE(flush_done, 0, 1);
+static K_MUTEX_DEFINE(flush_lock);
+
+static void (*lvgl_flush_cb)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+// The flush LVGL handed over. LVGL neither draws into its buffer nor starts
+// another flush until lv_disp_flush_ready, which the wrapped callback calls
+// when it is done.
+static lv_disp_drv_t *flush_drv;
+static lv_area_t flush_area;
+static lv_color_t *flush_buf;
+// The last flush of an LVGL refresh, which ends the latency pixel stage
+static bool flush_last;
+
+// Flush counters are only touched on the flush thread, waits on the
+// display queue
+static struct flush_async_stats stats;
+
+static void flush_work_cb(struct k_work *work) {
+    // Read first: once the wrapped callback returns, LVGL may hand over the
+    // next flush
+    bool last = flush_last;
+
+    k_mutex_lock(&flush_lock, K_FOREVER);
+    uint32_t start = k_cycle_get_32();
+    lvgl_flush_cb(flush_drv, &flush_area, flush_buf);
+    uint32_t busy = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    k_mutex_unlock(&flush_lock);
+
+    if (last) {
+        latency_flush_end();
+    }
+
+    stats.flushes++;
+    stats.busy_us_last = busy;
+    stats.busy_us_max = MAX(stats.busy_us_max, busy);
+    stats.busy_us_total += busy;
+    k_sem_give(&flush_done);
+}
+
+// Display queue: queue the flush and return, leaving LVGL's flushing flag set
+static void flush_async_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    flush_drv = drv;
+    flush_area = *area;
+    flush_buf = color_p;
+    flush_last = lv_disp_flush_is_last(drv);
+    if (flush_last) {
+        latency_flush_start();
+    }
+    k_sem_reset(&flush_done);
+    k_work_submit_to_queue(&flush_q, &flush_work);
+}
+
+// LVGL calls this in a loop while it waits for a flush to finish; block
+// instead of spinning, so the flush thread gets to run
+static void flush_async_wait_cb(lv_disp_drv_t *drv) {
+    uint32_t start = k_cycle_get_32();
+    k_sem_take(&flush_done, K_FOREVER);
+    stats.waits++;
+    stats.wait_us_total += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+void flush_async_init(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+
+    if (disp == NULL || lvgl_flush_cb != NULL) {
+        return;
+    }
+
+    const struct k_work_queue_config config = {.name = "nice_view_flush"};
+    k_work_queue_start(&flush_q, flush_stack, K_THREAD_STACK_SIZEOF(flush_stack),
+                       CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH_PRIORITY, &config);
+    k_work_init(&flush_work, flush_work_cb);
+
+    lvgl_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = flush_async_cb;
+    disp->driver->wait_cb = flush_async_wait_cb;
+
+    // What a full frame costs on the wire, to compare with the measured busy time
+    uint32_t bytes = PANEL_TRANSFER_BYTES(PANEL_HEIGHT);
+    LOG_INF("panel SPI %u Hz: full frame %u bytes, %u us on the wire", PANEL_SPI_FREQUENCY,
+            bytes, (uint32_t)((uint64_t)bytes * 8 * USEC_PER_SEC / PANEL_SPI_FREQUENCY));
+}
+
+void flush_async_get_stats(struct flush_async_stats *out) { *out = stats; }
+
+void flush_async_lock(void) { k_mutex_lock(&flush_lock, K_FOREVER); }
+
+void flush_async_unlock(void) { k_mutex_unlock(&flush_lock); }
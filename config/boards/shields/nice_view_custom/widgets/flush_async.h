@@ -0,0 +1,30 @@
+/*
+ * Custom Nice!View asynchronous panel flush
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct flush_async_stats {
+    uint32_t flushes;
+    // Time the flush thread spent per flush, mostly waiting on the SPI
+    // transfer; with PARTIAL_FLUSH it includes the line diff
+    uint32_t busy_us_last;
+    uint32_t busy_us_max;
+    uint64_t busy_us_total;
+    // LVGL needing the buffer of a flush still in progress and blocking on it
+    uint32_t waits;
+    uint64_t wait_us_total;
+};
+
+// Hand LVGL flushes to a dedicated thread, so the display work queue goes
+// back to listeners and rendering while the panel is written. Wraps the
+// current flush callback, so call it after panel_flush_init.
+void flush_async_init(void);
+void flush_async_get_stats(struct flush_async_stats *stats);
+
+// Hold off flushes, e.g. to read the panel shadow from another thread
+void flush_async_lock(void);
+void flush_async_unlock(void);
@@ -0,0 +1,203 @@
+/*
+ * Custom Nice!View keypress-to-pixel latency tracer
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+
+#include "latency.h"
+#include "util.h"
+
+// Log2 buckets of microseconds: bucket b counts samples below 2^(b + 1) us
+#define HIST_BUCKETS 24
+
+enum latency_stage {
+    // Event arrival to render start: event and display work queue delay
+    STAGE_QUEUE,
+    // Render start to render end
+    STAGE_RENDER,
+    // Event arrival to the end of the LVGL refresh that flushed the region,
+    // or with ASYNC_FLUSH to the flush thread finishing that refresh
+    STAGE_PIXEL,
+    STAGE_COUNT,
+};
+
+static const char *const stage_names[STAGE_COUNT] = {"queue", "render", "pixel"};
+static const char *const region_names[STATUS_REGION_COUNT] = {"top", "middle", "bottom"};
+
+struct latency_hist {
+    uint32_t buckets[HIST_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+};
+
+static struct latency_hist hists[STATUS_REGION_COUNT][STAGE_COUNT];
+
+// Cycle stamps with bit 0 forced on, so 0 always means "none"
+static atomic_t arrived[STATUS_REGION_COUNT];
+static uint32_t pending[STATUS_REGION_COUNT];
+static uint32_t render_start[STATUS_REGION_COUNT];
+static uint32_t rendered[STATUS_REGION_COUNT];
+// Handed to the flush thread, which records the pixel stage
+static atomic_t flushing[STATUS_REGION_COUNT];
+
+static void (*lvgl_monitor_cb)(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+
+static inline uint32_t stamp(void) { return k_cycle_get_32() | 1; }
+
+static void record(int region, enum latency_stage stage, uint32_t since) {
+    struct latency_hist *hist = &hists[region][stage];
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - since);
+    int bucket = us > 1 ? MIN(31 - __builtin_clz(us), HIST_BUCKETS - 1) : 0;
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->max_us = MAX(hist->max_us, us);
+}
+
+static int region_index(uint8_t region) { return __builtin_ctz(region); }
+
+void latency_event(uint8_t regions) {
+    uint32_t now = stamp();
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (regions & BIT(i)) {
+            // Keep the oldest event the display has not consumed yet
+            atomic_cas(&arrived[i], 0, now);
+        }
+    }
+}
+
+void latency_update(uint8_t regions, uint8_t dirty) {
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (!(regions & BIT(i))) {
+            continue;
+        }
+        uint32_t since = atomic_clear(&arrived[i]);
+        if ((dirty & BIT(i)) && since != 0 && pending[i] == 0) {
+            pending[i] = since;
+        }
+    }
+}
+
+void latency_render_start(uint8_t region) {
+    int i = region_index(region);
+    render_start[i] = stamp();
+    if (pending[i] != 0) {
+        record(i, STAGE_QUEUE, pending[i]);
+    }
+}
+
+void latency_render_end(uint8_t region) {
+    int i = region_index(region);
+    record(i, STAGE_RENDER, render_start[i]);
+    if (pending[i] != 0 && rendered[i] == 0) {
+        rendered[i] = pending[i];
+    }
+    pending[i] = 0;
+}
+
+// LVGL calls the monitor callback once a refresh has been flushed
+static void latency_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px) {
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        if (rendered[i] != 0) {
+            record(i, STAGE_PIXEL, rendered[i]);
+            rendered[i] = 0;
+        }
+    }
+    if (lvgl_monitor_cb != NULL) {
+        lvgl_monitor_cb(drv, time, px);
+    }
+}
+
+void latency_flush_start(void) {
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        // A flush still finishing keeps its stamp; this one goes with the next
+        if (rendered[i] != 0 && atomic_cas(&flushing[i], 0, rendered[i])) {
+            rendered[i] = 0;
+        }
+    }
+}
+
+void latency_flush_end(void) {
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        uint32_t since = atomic_clear(&flushing[i]);
+        if (since != 0) {
+            record(i, STAGE_PIXEL, since);
+        }
+    }
+}
+
+void latency_init(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+
+    // The monitor callback runs when the flush is only queued
+    if (IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)) {
+        return;
+    }
+
+    if (disp == NULL || disp->driver->monitor_cb == latency_monitor_cb) {
+        return;
+    }
+    lvgl_monitor_cb = disp->driver->monitor_cb;
+    disp->driver->monitor_cb = latency_monitor_cb;
+}
+
+// Upper bound of the bucket holding the given percentile
+static uint32_t percentile_us(const struct latency_hist *hist, int percent) {
+    uint32_t target = DIV_ROUND_UP((uint64_t)hist->count * percent, 100);
+    uint32_t seen = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        seen += hist->buckets[b];
+        if (seen >= target) {
+            return MIN(BIT(b + 1), hist->max_us);
+        }
+    }
+    return hist->max_us;
+}
+
+void latency_dump(const struct shell *sh) {
+    for (int i = 0; i < STATUS_REGION_COUNT; i++) {
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            const struct latency_hist *hist = &hists[i][s];
+            if (hist->count == 0) {
+                continue;
+            }
+            uint32_t p50 = percentile_us(hist, 50);
+            uint32_t p99 = percentile_us(hist, 99);
+#if IS_ENABLED(CONFIG_SHELL)
+            if (sh != NULL) {
+                shell_print(sh, "%-6s %-6s n=%u p50<=%uus p99<=%uus max=%uus", region_names[i],
+                            stage_names[s], hist->count, p50, p99, hist->max_us);
+                continue;
+            }
+#endif
+            LOG_INF("latency %s %s: n=%u p50<=%uus p99<=%uus max=%uus", region_names[i],
+                    stage_names[s], hist->count, p50, p99, hist->max_us);
+        }
+    }
+}
+
+#if CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY_LOG_INTERVAL > 0
+static void latency_log_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(latency_log_work, latency_log_work_cb);
+
+static void latency_log_work_cb(struct k_work *work) {
+    latency_dump(NULL);
+    k_work_schedule(&latency_log_work,
+                    K_SECONDS(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY_LOG_INTERVAL));
+}
+
+static int latency_log_init(void) {
+    k_work_schedule(&latency_log_work,
+                    K_SECONDS(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY_LOG_INTERVAL));
+    return 0;
+}
+
+SYS_INIT(latency_log_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif
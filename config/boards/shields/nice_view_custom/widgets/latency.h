@@ -0,0 +1,44 @@
+/*
+ * Custom Nice!View keypress-to-pixel latency tracer
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+struct shell;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+
+// Install the flush-complete hook; call once LVGL is up
+void latency_init(void);
+
+// Event thread: a status event for these regions arrived
+void latency_event(uint8_t regions);
+// Display queue: the listener consumed its event; regions still set in
+// `dirty` will be rendered for it
+void latency_update(uint8_t regions, uint8_t dirty);
+void latency_render_start(uint8_t region);
+void latency_render_end(uint8_t region);
+// With CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH the pixel stage follows the
+// flush thread instead of LVGL's monitor callback. Display queue: the last
+// flush of a refresh was handed over. Flush thread: it has been written.
+void latency_flush_start(void);
+void latency_flush_end(void);
+
+// Print p50/p99/max per region and stage, to the shell or to the log when sh is NULL
+void latency_dump(const struct shell *sh);
+
+#else
+
+static inline void latency_init(void) {}
+static inline void latency_event(uint8_t regions) {}
+static inline void latency_update(uint8_t regions, uint8_t dirty) {}
+static inline void latency_render_start(uint8_t region) {}
+static inline void latency_render_end(uint8_t region) {}
+static inline void latency_flush_start(void) {}
+static inline void latency_flush_end(void) {}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Custom Nice!View layer label table
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zmk/keymap.h>
+
+#include "layer_labels.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+#include "text_cache.h"
+#endif
+
+static const lv_font_t *label_font;
+static struct layer_label labels[ZMK_KEYMAP_LAYERS_LEN];
+// Returned for indexes outside the keymap, e.g. before the table is built
+static const struct layer_label unknown = {.text = "", .width = 0};
+
+// The label text the keymap currently gives the layer at index
+static void resolve_text(uint8_t index, char *text, size_t len) {
+    const char *name = zmk_keymap_layer_name(zmk_keymap_layer_index_to_id(index));
+    if (name == NULL || name[0] == '\0') {
+        snprintf(text, len, "LAYER %i", index);
+    } else {
+        snprintf(text, len, "%s", name);
+    }
+}
+
+static void set_label(uint8_t index, const char *text) {
+    struct layer_label *label = &labels[index];
+
+    strcpy(label->text, text);
+    label->width = lv_txt_get_width(text, strlen(text), label_font, 0, LV_TEXT_FLAG_NONE);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+    text_cache_get(label_font, text);
+#endif
+}
+
+void layer_labels_init(const lv_font_t *font) {
+    char text[LAYER_LABEL_LEN];
+
+    label_font = font;
+    for (int i = 0; i < ZMK_KEYMAP_LAYERS_LEN; i++) {
+        resolve_text(i, text, sizeof(text));
+        set_label(i, text);
+    }
+}
+
+bool layer_labels_stale(uint8_t index) {
+    char text[LAYER_LABEL_LEN];
+
+    if (index >= ZMK_KEYMAP_LAYERS_LEN || label_font == NULL) {
+        return false;
+    }
+    resolve_text(index, text, sizeof(text));
+    return strcmp(text, labels[index].text) != 0;
+}
+
+void layer_labels_refresh(uint8_t index) {
+    char text[LAYER_LABEL_LEN];
+
+    if (index >= ZMK_KEYMAP_LAYERS_LEN || label_font == NULL) {
+        return;
+    }
+    resolve_text(index, text, sizeof(text));
+    if (strcmp(text, labels[index].text) != 0) {
+        set_label(index, text);
+    }
+}
+
+const struct layer_label *layer_labels_get(uint8_t index) {
+    if (index >= ZMK_KEYMAP_LAYERS_LEN || label_font == NULL) {
+        return &unknown;
+    }
+    return &labels[index];
+}
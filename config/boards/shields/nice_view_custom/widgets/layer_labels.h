@@ -0,0 +1,35 @@
+/*
+ * Custom Nice!View layer label table
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Longer names are cut; the bottom region only fits a few characters anyway
+#define LAYER_LABEL_LEN 24
+
+struct layer_label {
+    // Keymap display name, or "LAYER n" when the layer has none
+    char text[LAYER_LABEL_LEN];
+    // Width of text in the font the table was built for
+    lv_coord_t width;
+};
+
+// Resolve every keymap layer's label once, conditional layers included, and
+// measure it in font. With the text cache enabled the labels are also
+// rasterized up front, so the first switch to each layer is a cache hit.
+void layer_labels_init(const lv_font_t *font);
+
+// Whether the keymap's name for the layer at index differs from its label,
+// e.g. after the layer was renamed at runtime
+bool layer_labels_stale(uint8_t index);
+
+// Re-resolve and re-measure the label at index if it is stale. The table is
+// read while drawing, so call this only while no region is being drawn.
+void layer_labels_refresh(uint8_t index);
+
+const struct layer_label *layer_labels_get(uint8_t index);
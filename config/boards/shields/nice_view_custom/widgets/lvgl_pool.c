@@ -0,0 +1,62 @@
+/*
+ * Custom Nice!View LVGL pool accounting
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "lvgl_pool.h"
+
+struct alloc_hdr {
+    size_t size;
+} __aligned(8);
+
+static struct lvgl_pool_stats stats;
+
+void *__real_lvgl_malloc(size_t size);
+void *__real_lvgl_realloc(void *ptr, size_t size);
+void __real_lvgl_free(void *ptr);
+
+void *__wrap_lvgl_malloc(size_t size) {
+    struct alloc_hdr *hdr = __real_lvgl_malloc(sizeof(*hdr) + size);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    hdr->size = size;
+    stats.allocs++;
+    stats.in_use += size;
+    stats.peak = MAX(stats.peak, stats.in_use);
+    stats.window_peak = MAX(stats.window_peak, stats.in_use);
+    return hdr + 1;
+}
+
+void __wrap_lvgl_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    struct alloc_hdr *hdr = (struct alloc_hdr *)ptr - 1;
+    stats.in_use -= hdr->size;
+    __real_lvgl_free(hdr);
+}
+
+void *__wrap_lvgl_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return __wrap_lvgl_malloc(size);
+    }
+    struct alloc_hdr *hdr = (struct alloc_hdr *)ptr - 1;
+    size_t old_size = hdr->size;
+    hdr = __real_lvgl_realloc(hdr, sizeof(*hdr) + size);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    hdr->size = size;
+    stats.allocs++;
+    stats.in_use = stats.in_use - old_size + size;
+    stats.peak = MAX(stats.peak, stats.in_use);
+    stats.window_peak = MAX(stats.window_peak, stats.in_use);
+    return hdr + 1;
+}
+
+void lvgl_pool_get_stats(struct lvgl_pool_stats *out) { *out = stats; }
+
+void lvgl_pool_start_window(void) { stats.window_peak = stats.in_use; }
@@ -0,0 +1,24 @@
+/*
+ * Custom Nice!View LVGL pool accounting
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// LVGL's allocator is wrapped at link time (see CMakeLists.txt) to count
+// allocations and track how much of the LV_Z_MEM_POOL_SIZE pool is in use.
+// Each block carries its size in a small header, paid for in pool space.
+struct lvgl_pool_stats {
+    uint32_t allocs;
+    size_t in_use;
+    // High-water marks since boot and since the last lvgl_pool_start_window
+    size_t peak;
+    size_t window_peak;
+};
+
+void lvgl_pool_get_stats(struct lvgl_pool_stats *stats);
+// Restart the windowed high-water mark from the current use
+void lvgl_pool_start_window(void);
@@ -0,0 +1,130 @@
+/*
+ * Custom Nice!View display RAM report
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/linker-defs.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "lvgl_pool.h"
+#include "mem_report.h"
+#include "panel_flush.h"
+#include "scratch.h"
+#if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include "custom_status.h"
+#define STATUS_WIDGET_SIZE sizeof(struct zmk_widget_custom_status)
+#else
+#include "peripheral_status.h"
+#define STATUS_WIDGET_SIZE sizeof(struct zmk_widget_peripheral_status)
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+#include "text_cache.h"
+#endif
+
+// Same sizing as the Zephyr LVGL module's static draw buffer
+#define LVGL_VDB_SIZE                                                                              \
+    (CONFIG_LV_Z_BITS_PER_PIXEL * ((CONFIG_LV_Z_VDB_SIZE * PANEL_WIDTH * PANEL_HEIGHT) / 100) / 8)
+#if IS_ENABLED(CONFIG_LV_Z_DOUBLE_VDB)
+#define LVGL_VDB_COUNT 2
+#else
+#define LVGL_VDB_COUNT 1
+#endif
+
+#define MEM_REPORT_LOG_DELAY_SEC 30
+
+// used < 0 when the fill level is not tracked
+static void report_line(const struct shell *sh, const char *name, uint32_t size, int32_t used) {
+#if IS_ENABLED(CONFIG_SHELL)
+    if (sh != NULL) {
+        if (used < 0) {
+            shell_print(sh, "%-14s %6u", name, size);
+        } else {
+            shell_print(sh, "%-14s %6u  peak %u", name, size, used);
+        }
+        return;
+    }
+#endif
+    if (used < 0) {
+        LOG_INF("mem %s: %u", name, size);
+    } else {
+        LOG_INF("mem %s: %u peak %u", name, size, used);
+    }
+}
+
+void mem_report_dump(const struct shell *sh) {
+    uint32_t display = 0;
+
+    report_line(sh, "widget", STATUS_WIDGET_SIZE, -1);
+    display += STATUS_WIDGET_SIZE;
+
+    struct scratch_stats scratch;
+    scratch_get_stats(&scratch);
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+    report_line(sh, "scratch canvas", CANVAS_SIZE * CANVAS_SIZE * sizeof(lv_color_t), -1);
+    display += CANVAS_SIZE * CANVAS_SIZE * sizeof(lv_color_t);
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+    report_line(sh, "scratch packed", CANVAS_STRIDE_1BPP * CANVAS_SIZE, -1);
+    display += CANVAS_STRIDE_1BPP * CANVAS_SIZE;
+#endif
+#endif
+    report_line(sh, "scratch arena", scratch.size, scratch.peak);
+    display += scratch.size;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+    struct text_cache_stats text;
+    text_cache_get_stats(&text);
+    report_line(sh, "text cache", CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE_SIZE, text.bytes_used);
+    display += CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE_SIZE;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+    report_line(sh, "panel shadow", PANEL_FRAME_SIZE + PANEL_HEIGHT, -1);
+    display += PANEL_FRAME_SIZE + PANEL_HEIGHT;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+    report_line(sh, "snapshot", PANEL_FRAME_SIZE, -1);
+    display += PANEL_FRAME_SIZE;
+#endif
+
+    struct lvgl_pool_stats pool;
+    lvgl_pool_get_stats(&pool);
+    report_line(sh, "lvgl pool", CONFIG_LV_Z_MEM_POOL_SIZE, pool.peak);
+    display += CONFIG_LV_Z_MEM_POOL_SIZE;
+
+    report_line(sh, "lvgl vdb", LVGL_VDB_COUNT * LVGL_VDB_SIZE, -1);
+    display += LVGL_VDB_COUNT * LVGL_VDB_SIZE;
+
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+    report_line(sh, "display stack", CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_STACK_SIZE, -1);
+    display += CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_STACK_SIZE;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    report_line(sh, "render stack", CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_STACK_SIZE, -1);
+    display += CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_STACK_SIZE;
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+    report_line(sh, "flush stack", CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH_STACK_SIZE, -1);
+    display += CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH_STACK_SIZE;
+#endif
+
+    // The static RAM image: .data, .bss and .noinit, which hold the thread
+    // stacks and the LVGL pool as well
+    uint32_t image = _image_ram_end - _image_ram_start;
+    report_line(sh, "display total", display, -1);
+    report_line(sh, "rest", image > display ? image - display : 0, -1);
+    report_line(sh, "ram image", image, -1);
+}
+
+static void mem_report_log_cb(struct k_work *work) { mem_report_dump(NULL); }
+
+static K_WORK_DELAYABLE_DEFINE(mem_report_log_work, mem_report_log_cb);
+
+// Logged once boot, the staged widget init and the bench are done
+static int mem_report_log_init(void) {
+    k_work_schedule(&mem_report_log_work, K_SECONDS(MEM_REPORT_LOG_DELAY_SEC));
+    return 0;
+}
+
+SYS_INIT(mem_report_log_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,13 @@
+/*
+ * Custom Nice!View display RAM report
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+struct shell;
+
+// Print the RAM held by the display and widget against the whole static RAM
+// image, with fill levels where they are tracked, to the shell or to the log
+// when sh is NULL
+void mem_report_dump(const struct shell *sh);
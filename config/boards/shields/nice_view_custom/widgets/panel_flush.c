@@ -0,0 +1,135 @@
+/*
+ * Custom Nice!View line-diff panel flush
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+
+#include "panel_flush.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+#include "snapshot.h"
+#endif
+
+static const struct device *display_dev = DEVICE_DT_GET(PANEL_NODE);
+
+// Last content written to each panel line; a line is only trusted once it
+// has been written through this path
+static uint8_t shadow[PANEL_FRAME_SIZE];
+static bool line_valid[PANEL_HEIGHT];
+static bool first_frame_logged;
+
+static void (*lvgl_flush_cb)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+static struct panel_flush_stats stats;
+
+static void write_lines(int y, int count, const uint8_t *buf) {
+    struct display_buffer_descriptor desc = {
+        .buf_size = count * PANEL_STRIDE,
+        .width = PANEL_WIDTH,
+        .pitch = PANEL_WIDTH,
+        .height = count,
+    };
+    display_write(display_dev, 0, y, &desc, buf);
+}
+
+static void panel_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+    // The LS0xx rounder always widens areas to full lines; anything else
+    // goes through the stock flush and invalidates the shadow lines it covers
+    if (area->x1 != 0 || area->x2 != PANEL_WIDTH - 1) {
+        for (int y = area->y1; y <= area->y2; y++) {
+            line_valid[y] = false;
+        }
+        lvgl_flush_cb(drv, area, color_p);
+        return;
+    }
+
+    const uint8_t *buf = (const uint8_t *)color_p;
+    int lines = area->y2 - area->y1 + 1;
+    int run_start = -1;
+    int sent = 0;
+    uint32_t bytes = 0;
+
+    for (int i = 0; i <= lines; i++) {
+        bool changed = false;
+        if (i < lines) {
+            int y = area->y1 + i;
+            uint8_t *line = &shadow[y * PANEL_STRIDE];
+            const uint8_t *src = &buf[i * PANEL_STRIDE];
+            if (!line_valid[y] || memcmp(line, src, PANEL_STRIDE) != 0) {
+                memcpy(line, src, PANEL_STRIDE);
+                line_valid[y] = true;
+                changed = true;
+            }
+        }
+
+        if (changed && run_start < 0) {
+            run_start = i;
+        } else if (!changed && run_start >= 0) {
+            write_lines(area->y1 + run_start, i - run_start, &buf[run_start * PANEL_STRIDE]);
+            sent += i - run_start;
+            bytes += PANEL_TRANSFER_BYTES(i - run_start);
+            run_start = -1;
+        }
+    }
+
+    stats.flushes++;
+    stats.lines_requested += lines;
+    stats.lines_sent += sent;
+    stats.bytes_requested += PANEL_TRANSFER_BYTES(lines);
+    stats.bytes_sent += bytes;
+    LOG_DBG("panel flush: %d/%d lines, %u/%u bytes", sent, lines, bytes,
+            PANEL_TRANSFER_BYTES(lines));
+
+    if (!first_frame_logged) {
+        first_frame_logged = true;
+        LOG_INF("boot to first live frame: %u ms", k_uptime_get_32());
+    }
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+    if (sent > 0) {
+        snapshot_frame_changed();
+    }
+#endif
+
+    lv_disp_flush_ready(drv);
+}
+
+void panel_flush_init(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+
+    if (disp == NULL || !device_is_ready(display_dev) || lvgl_flush_cb != NULL) {
+        return;
+    }
+    lvgl_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = panel_flush_cb;
+}
+
+void panel_flush_get_stats(struct panel_flush_stats *out) { *out = stats; }
+
+int panel_flush_preload(const uint8_t *frame) {
+    if (!device_is_ready(display_dev)) {
+        return -ENODEV;
+    }
+
+    memcpy(shadow, frame, sizeof(shadow));
+    for (int y = 0; y < PANEL_HEIGHT; y++) {
+        line_valid[y] = true;
+    }
+    write_lines(0, PANEL_HEIGHT, shadow);
+    return display_blanking_off(display_dev);
+}
+
+const uint8_t *panel_flush_frame(void) {
+    for (int y = 0; y < PANEL_HEIGHT; y++) {
+        if (!line_valid[y]) {
+            return NULL;
+        }
+    }
+    return shadow;
+}
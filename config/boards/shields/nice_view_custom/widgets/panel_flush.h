@@ -0,0 +1,45 @@
+/*
+ * Custom Nice!View line-diff panel flush
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/devicetree.h>
+
+#define PANEL_NODE DT_CHOSEN(zephyr_display)
+#define PANEL_WIDTH DT_PROP(PANEL_NODE, width)
+#define PANEL_HEIGHT DT_PROP(PANEL_NODE, height)
+#define PANEL_STRIDE (PANEL_WIDTH / 8)
+#define PANEL_FRAME_SIZE (PANEL_HEIGHT * PANEL_STRIDE)
+#define PANEL_SPI_FREQUENCY DT_PROP(PANEL_NODE, spi_max_frequency)
+
+// LS0xx write framing: a mode byte and a trailing dummy byte per transfer,
+// plus an address byte and a dummy byte around every line
+#define LS0XX_TRANSFER_BYTES 2
+#define LS0XX_LINE_BYTES (PANEL_STRIDE + 2)
+#define PANEL_TRANSFER_BYTES(lines) (LS0XX_TRANSFER_BYTES + (lines) * LS0XX_LINE_BYTES)
+
+struct panel_flush_stats {
+    uint32_t flushes;
+    // Lines LVGL asked to flush vs. lines that actually differed
+    uint32_t lines_requested;
+    uint32_t lines_sent;
+    // SPI bytes including LS0xx framing, without and with the line diff
+    uint32_t bytes_requested;
+    uint32_t bytes_sent;
+};
+
+// Route LVGL flushes through a shadow framebuffer so only changed lines
+// are written to the panel. Call once LVGL and the display are up.
+void panel_flush_init(void);
+void panel_flush_get_stats(struct panel_flush_stats *stats);
+
+// Write a full PANEL_FRAME_SIZE frame straight to the panel and seed the
+// shadow with it, so the first LVGL frame only sends lines that differ.
+// Works before panel_flush_init.
+int panel_flush_preload(const uint8_t *frame);
+
+// Panel content as last written, or NULL until every line has been written
+const uint8_t *panel_flush_frame(void);
@@ -1,6 +1,6 @@
 /*
  * Custom Nice!View Peripheral Status Widget
- * Battery with % inside + mountain art
+ * Top bar + mountain art
  * SPDX-License-Identifier: MIT
  */
 
@@ -8,142 +8,150 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-#include <zmk/battery.h>
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
-#include <zmk/events/battery_state_changed.h>
-#include <zmk/events/usb_conn_state_changed.h>
-#include <zmk/usb.h>
-#include <zmk/split/bluetooth/peripheral.h>
-#include <zmk/events/split_peripheral_status_changed.h>
+#include <zmk/activity.h>
+#include <zmk/events/activity_state_changed.h>
 
 #include "util.h"
+#include "latency.h"
+#include "queue_stats.h"
 #include "peripheral_status.h"
-
-LV_IMG_DECLARE(bolt);
-LV_IMG_DECLARE(mountain);
+#include "nv_assets.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+#include "bench.h"
+#endif
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
-struct peripheral_status_state {
-    bool connected;
-};
+// Redraw only the regions whose inputs changed
+static void draw_dirty(struct zmk_widget_peripheral_status *widget) {
+    // Regions still waiting for their init stage keep their dirty bit
+    uint8_t dirty = widget->state.dirty & widget->state.ready;
+    widget->state.dirty &= ~dirty;
 
-static void draw_top(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-    lv_obj_t *canvas = lv_obj_get_child(widget, 0);
-
-    lv_draw_rect_dsc_t rect_black_dsc;
-    init_rect_dsc(&rect_black_dsc, LVGL_BACKGROUND);
-    lv_draw_rect_dsc_t rect_white_dsc;
-    init_rect_dsc(&rect_white_dsc, LVGL_FOREGROUND);
-    lv_draw_label_dsc_t label_dsc;
-    init_label_dsc(&label_dsc, LVGL_FOREGROUND, &lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER);
-    lv_draw_label_dsc_t label_dsc_right;
-    init_label_dsc(&label_dsc_right, LVGL_FOREGROUND, &lv_font_montserrat_16, LV_TEXT_ALIGN_RIGHT);
-
-    lv_canvas_draw_rect(canvas, 0, 0, CANVAS_SIZE, CANVAS_SIZE, &rect_black_dsc);
-
-    // Connection status (top right)
-    lv_canvas_draw_text(canvas, 40, 0, CANVAS_SIZE - 42, &label_dsc_right,
-                        state->connected ? LV_SYMBOL_WIFI : LV_SYMBOL_CLOSE);
-
-    // Battery outline with fill level
-    lv_canvas_draw_rect(canvas, 0, 2, 29, 12, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 1, 3, 27, 10, &rect_black_dsc);
-    lv_canvas_draw_rect(canvas, 2, 4, (state->battery * 25) / 100, 8, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 29, 4, 3, 6, &rect_white_dsc);
-    lv_canvas_draw_rect(canvas, 30, 5, 1, 4, &rect_black_dsc);
-
-    // Battery percentage text inside
-    char bat_text[5];
-    snprintf(bat_text, sizeof(bat_text), "%d", state->battery);
-    lv_canvas_draw_text(canvas, 0, 0, 29, &label_dsc, bat_text);
-
-    // Charging bolt
-    if (state->charging) {
-        lv_draw_img_dsc_t img_dsc;
-        lv_draw_img_dsc_init(&img_dsc);
-        lv_canvas_draw_img(canvas, 9, -1, &bolt, &img_dsc);
+    if (dirty & STATUS_REGION_TOP) {
+        latency_render_start(STATUS_REGION_TOP);
+        top_bar_draw(&widget->top, &widget->state);
+        latency_render_end(STATUS_REGION_TOP);
     }
-
-    rotate_canvas(canvas, cbuf);
 }
 
-static void set_battery_status(struct zmk_widget_peripheral_status *widget,
-                               struct battery_status_state state) {
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-    widget->state.charging = state.usb_present;
-#endif
-    widget->state.battery = state.level;
-    draw_top(widget->obj, widget->cbuf, &widget->state);
+static void render_frame(struct render_sched *sched) {
+    draw_dirty(CONTAINER_OF(sched, struct zmk_widget_peripheral_status, sched));
 }
 
-static void battery_status_update_cb(struct battery_status_state state) {
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+struct activity_status_state {
+    enum zmk_activity_state state;
+};
+
+static void activity_update_cb(struct activity_status_state state) {
     struct zmk_widget_peripheral_status *widget;
+    queue_stats_run(QUEUE_LISTENER_ACTIVITY);
     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_battery_status(widget, state);
+        render_sched_set_idle(&widget->sched, state.state != ZMK_ACTIVITY_ACTIVE);
     }
 }
 
-static struct battery_status_state battery_status_get_state(const zmk_event_t *eh) {
-    return (struct battery_status_state){
-        .level = zmk_battery_state_of_charge(),
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-        .usb_present = zmk_usb_is_powered(),
-#endif
-    };
+static struct activity_status_state activity_get_state(const zmk_event_t *eh) {
+    if (eh != NULL) {
+        queue_stats_event(QUEUE_LISTENER_ACTIVITY);
+    }
+    return (struct activity_status_state){.state = zmk_activity_get_state()};
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_battery_status, struct battery_status_state,
-                            battery_status_update_cb, battery_status_get_state)
-ZMK_SUBSCRIPTION(widget_battery_status, zmk_battery_state_changed);
-#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-ZMK_SUBSCRIPTION(widget_battery_status, zmk_usb_conn_state_changed);
+ZMK_DISPLAY_WIDGET_LISTENER(widget_activity, struct activity_status_state, activity_update_cb,
+                            activity_get_state)
+ZMK_SUBSCRIPTION(widget_activity, zmk_activity_state_changed);
 #endif
 
-static struct peripheral_status_state get_state(const zmk_event_t *_eh) {
-    return (struct peripheral_status_state){.connected = zmk_split_bt_peripheral_is_connected()};
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+static void bench_top(void *data) {
+    struct zmk_widget_peripheral_status *widget = data;
+    top_bar_draw(&widget->top, &widget->state);
 }
 
-static void set_connection_status(struct zmk_widget_peripheral_status *widget,
-                                  struct peripheral_status_state state) {
-    widget->state.connected = state.connected;
-    draw_top(widget->obj, widget->cbuf, &widget->state);
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+static void bench_rotate(void *data) {
+    struct zmk_widget_peripheral_status *widget = data;
+    struct region_draw draw;
+    region_draw_begin(&draw, &widget->region_top);
+    region_draw_end(&draw);
 }
+#endif
 
-static void output_status_update_cb(struct peripheral_status_state state) {
-    struct zmk_widget_peripheral_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
-        set_connection_status(widget, state);
-    }
+static void run_bench(struct zmk_widget_peripheral_status *widget) {
+    render_bench_run("top", bench_top, widget);
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+    render_bench_run("rotate", bench_rotate, widget);
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+    render_bench_rotate_ab("rotate_ab", bench_top, widget);
+#endif
+#endif
+    widget->state.dirty = STATUS_REGION_ALL;
 }
+#endif
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_peripheral_status, struct peripheral_status_state,
-                            output_status_update_cb, get_state)
-ZMK_SUBSCRIPTION(widget_peripheral_status, zmk_split_peripheral_status_changed);
+// Init stages: layout and placeholder first, then the status region once its
+// data sources are queried and its listeners set up
 
-int zmk_widget_peripheral_status_init(struct zmk_widget_peripheral_status *widget, lv_obj_t *parent) {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 160, 68);
+static void init_layout(void *data) {
+    struct zmk_widget_peripheral_status *widget = data;
 
     lv_obj_t *top = lv_canvas_create(widget->obj);
     lv_obj_align(top, LV_ALIGN_TOP_RIGHT, 0, 0);
-    lv_canvas_set_buffer(top, widget->cbuf, CANVAS_SIZE, CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR);
+    region_init_canvas(&widget->region_top, top, widget->cbuf);
+    draw_placeholder(&widget->region_top);
 
     // Mountain art
     lv_obj_t *art = lv_img_create(widget->obj);
     lv_img_set_src(art, &mountain);
     lv_obj_align(art, LV_ALIGN_TOP_LEFT, 0, 0);
 
+    widget->state.dirty = 0;
+    widget->state.ready = 0;
+    render_sched_init(&widget->sched, render_frame);
     sys_slist_append(&widgets, &widget->node);
+}
+
+static void init_top(void *data) {
+    struct zmk_widget_peripheral_status *widget = data;
 
-    widget->state.battery = zmk_battery_state_of_charge();
-    widget->state.connected = zmk_split_bt_peripheral_is_connected();
+    top_bar_init(&widget->top, &widget->region_top, &widget->state, &widget->sched);
 
-    widget_battery_status_init();
-    widget_peripheral_status_init();
+    widget->state.ready |= STATUS_REGION_TOP;
+    widget->state.dirty |= STATUS_REGION_TOP;
+    draw_dirty(widget);
+}
+
+static void init_finish(void *data) {
+    struct zmk_widget_peripheral_status *widget = data;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    widget_activity_init();
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_BENCH)
+    run_bench(widget);
+    draw_dirty(widget);
+#else
+    ARG_UNUSED(widget);
+#endif
+}
+
+static const struct init_stage init_stages[] = {
+    {"layout", init_layout},
+    {"top", init_top},
+    {"finish", init_finish},
+};
+
+int zmk_widget_peripheral_status_init(struct zmk_widget_peripheral_status *widget,
+                                      lv_obj_t *parent) {
+    draw_dsc_init();
+    widget->obj = lv_obj_create(parent);
+    lv_obj_set_size(widget->obj, 160, 68);
 
-    draw_top(widget->obj, widget->cbuf, &widget->state);
+    staged_init_start(&widget->init, init_stages, ARRAY_SIZE(init_stages), widget);
 
     return 0;
 }
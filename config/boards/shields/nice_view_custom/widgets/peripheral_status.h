@@ -8,13 +8,21 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 #include "util.h"
+#include "render_sched.h"
+#include "staged_init.h"
+#include "top_bar.h"
 
 struct zmk_widget_peripheral_status {
     sys_snode_t node;
     lv_obj_t *obj;
-    lv_color_t cbuf[CANVAS_SIZE * CANVAS_SIZE];
+    uint8_t cbuf[CANVAS_BUF_SIZE] __aligned(4);
+    struct region region_top;
     struct status_state state;
+    struct render_sched sched;
+    struct staged_init init;
+    struct top_bar top;
 };
 
-int zmk_widget_peripheral_status_init(struct zmk_widget_peripheral_status *widget, lv_obj_t *parent);
+int zmk_widget_peripheral_status_init(struct zmk_widget_peripheral_status *widget,
+                                      lv_obj_t *parent);
 lv_obj_t *zmk_widget_peripheral_status_obj(struct zmk_widget_peripheral_status *widget);
@@ -0,0 +1,128 @@
+/*
+ * Custom Nice!View display work queue backlog counters
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "queue_stats.h"
+
+static const char *const listener_names[QUEUE_LISTENER_COUNT] = {
+    "battery", "connection", "layer", "wpm", "keycode", "activity", "periph_bat",
+};
+
+// Events come from whichever thread raised them, so the event side is atomic.
+// The display queue side only runs on the display queue.
+static ATOMIC_DEFINE(pending, QUEUE_LISTENER_COUNT);
+static atomic_t depth;
+static atomic_t max_depth;
+static atomic_t events[QUEUE_LISTENER_COUNT];
+static atomic_t coalesced[QUEUE_LISTENER_COUNT];
+// Arrival of the oldest event each pending work item carries
+static uint32_t queued_at[QUEUE_LISTENER_COUNT];
+
+static struct queue_stats stats;
+
+void queue_stats_event(enum queue_listener listener) {
+    atomic_inc(&events[listener]);
+
+    // The listener macro submits the same work item for every event, so an
+    // event that finds it pending only overwrites the state it will read
+    if (atomic_test_and_set_bit(pending, listener)) {
+        atomic_inc(&coalesced[listener]);
+        return;
+    }
+    queued_at[listener] = k_cycle_get_32();
+
+    atomic_val_t now = atomic_inc(&depth) + 1;
+    atomic_val_t max = atomic_get(&max_depth);
+    while (now > max && !atomic_cas(&max_depth, max, now)) {
+        max = atomic_get(&max_depth);
+    }
+}
+
+void queue_stats_run(enum queue_listener listener) {
+    struct queue_listener_stats *entry = &stats.listeners[listener];
+
+    entry->runs++;
+    // Not pending for the init call, or when an event landed between the
+    // listener reading its state and this hook; that one is counted as
+    // coalesced although its work item runs again
+    if (!atomic_test_and_clear_bit(pending, listener)) {
+        return;
+    }
+    atomic_dec(&depth);
+
+    uint32_t lag_us = k_cyc_to_us_floor32(k_cycle_get_32() - queued_at[listener]);
+    entry->max_lag_us = MAX(entry->max_lag_us, lag_us);
+    entry->lag_sum_us += lag_us;
+}
+
+void queue_stats_render(uint32_t cycles) {
+    uint32_t us = k_cyc_to_us_floor32(cycles);
+
+    stats.frames++;
+    stats.max_render_us = MAX(stats.max_render_us, us);
+    stats.render_sum_us += us;
+}
+
+void queue_stats_get(struct queue_stats *out) {
+    *out = stats;
+    for (int i = 0; i < QUEUE_LISTENER_COUNT; i++) {
+        out->listeners[i].events = atomic_get(&events[i]);
+        out->listeners[i].coalesced = atomic_get(&coalesced[i]);
+    }
+    out->max_depth = atomic_get(&max_depth);
+}
+
+void queue_stats_reset(void) {
+    stats = (struct queue_stats){};
+    for (int i = 0; i < QUEUE_LISTENER_COUNT; i++) {
+        atomic_clear(&events[i]);
+        atomic_clear(&coalesced[i]);
+    }
+    // Items still pending keep counting towards the depth
+    atomic_set(&max_depth, atomic_get(&depth));
+}
+
+void queue_stats_dump(const struct shell *sh) {
+    struct queue_stats snap;
+    uint32_t total_events = 0;
+
+    queue_stats_get(&snap);
+    for (int i = 0; i < QUEUE_LISTENER_COUNT; i++) {
+        const struct queue_listener_stats *entry = &snap.listeners[i];
+        if (entry->events == 0 && entry->runs == 0) {
+            continue;
+        }
+        total_events += entry->events;
+        uint32_t avg_lag = entry->runs > 0 ? entry->lag_sum_us / entry->runs : 0;
+#if IS_ENABLED(CONFIG_SHELL)
+        if (sh != NULL) {
+            shell_print(sh, "%-10s events %u coalesced %u runs %u lag avg %uus max %uus",
+                        listener_names[i], entry->events, entry->coalesced, entry->runs,
+                        avg_lag, entry->max_lag_us);
+            continue;
+        }
+#endif
+        LOG_INF("queue %s: events %u coalesced %u runs %u lag avg %uus max %uus",
+                listener_names[i], entry->events, entry->coalesced, entry->runs, avg_lag,
+                entry->max_lag_us);
+    }
+
+    uint32_t avg_render = snap.frames > 0 ? snap.render_sum_us / snap.frames : 0;
+    uint32_t per_event = total_events > 0 ? snap.render_sum_us / total_events : 0;
+#if IS_ENABLED(CONFIG_SHELL)
+    if (sh != NULL) {
+        shell_print(sh, "max depth %u frames %u render avg %uus max %uus per event %uus",
+                    snap.max_depth, snap.frames, avg_render, snap.max_render_us, per_event);
+        return;
+    }
+#endif
+    LOG_INF("queue: max depth %u frames %u render avg %uus max %uus per event %uus",
+            snap.max_depth, snap.frames, avg_render, snap.max_render_us, per_event);
+}
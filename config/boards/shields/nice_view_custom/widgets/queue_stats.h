@@ -0,0 +1,64 @@
+/*
+ * Custom Nice!View display work queue backlog counters
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+struct shell;
+
+// Each widget listener owns one work item on the display queue
+enum queue_listener {
+    QUEUE_LISTENER_BATTERY,
+    QUEUE_LISTENER_CONNECTION,
+    QUEUE_LISTENER_LAYER,
+    QUEUE_LISTENER_WPM,
+    QUEUE_LISTENER_KEYCODE,
+    QUEUE_LISTENER_ACTIVITY,
+    QUEUE_LISTENER_PERIPHERAL_BATTERY,
+    QUEUE_LISTENER_COUNT,
+};
+
+struct queue_listener_stats {
+    uint32_t events;
+    // Events whose state replaced one still waiting in the queue; the older
+    // state is never drawn
+    uint32_t coalesced;
+    uint32_t runs;
+    uint32_t max_lag_us;
+    uint64_t lag_sum_us;
+};
+
+struct queue_stats {
+    struct queue_listener_stats listeners[QUEUE_LISTENER_COUNT];
+    // Listener work items pending on the display queue at once
+    uint32_t max_depth;
+    uint32_t frames;
+    uint32_t max_render_us;
+    uint64_t render_sum_us;
+};
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_QUEUE_STATS)
+
+// Event thread: the listener stored new state and submits its work item
+void queue_stats_event(enum queue_listener listener);
+// Display queue: the listener's work item is running
+void queue_stats_run(enum queue_listener listener);
+// Display queue: a frame took this many cycles to render
+void queue_stats_render(uint32_t cycles);
+
+void queue_stats_get(struct queue_stats *stats);
+void queue_stats_reset(void);
+// Print per-listener and render counters, to the shell or to the log when sh is NULL
+void queue_stats_dump(const struct shell *sh);
+
+#else
+
+static inline void queue_stats_event(enum queue_listener listener) {}
+static inline void queue_stats_run(enum queue_listener listener) {}
+static inline void queue_stats_render(uint32_t cycles) {}
+
+#endif
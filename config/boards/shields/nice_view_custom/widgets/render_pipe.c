@@ -0,0 +1,69 @@
+/*
+ * Custom Nice!View render thread pipeline
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zmk/display.h>
+
+#include "render_pipe.h"
+
+static K_THREAD_STACK_DEFINE(render_stack,
+                             CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_STACK_SIZE);
+static struct k_work_q render_q;
+static bool render_q_started;
+
+// frames and busy are only touched on the display queue, the draw times
+// only on the render thread
+static struct render_pipe_stats stats;
+
+static void render_pipe_draw_work(struct k_work *work) {
+    struct render_pipe *pipe = CONTAINER_OF(work, struct render_pipe, draw_work);
+    uint32_t start = k_cycle_get_32();
+
+    pipe->draw(pipe);
+
+    stats.draw_us_last = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    stats.draw_us_max = MAX(stats.draw_us_max, stats.draw_us_last);
+    k_work_submit_to_queue(zmk_display_work_q(), &pipe->publish_work);
+}
+
+static void render_pipe_publish_work(struct k_work *work) {
+    struct render_pipe *pipe = CONTAINER_OF(work, struct render_pipe, publish_work);
+
+    stats.frames++;
+    pipe->publish(pipe);
+    pipe->busy = false;
+}
+
+void render_pipe_init(struct render_pipe *pipe, render_pipe_take_fn take,
+                      render_pipe_draw_fn draw, render_pipe_publish_fn publish) {
+    if (!render_q_started) {
+        const struct k_work_queue_config config = {.name = "nice_view_render"};
+        k_work_queue_start(&render_q, render_stack, K_THREAD_STACK_SIZEOF(render_stack),
+                           CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD_PRIORITY, &config);
+        render_q_started = true;
+    }
+
+    k_work_init(&pipe->draw_work, render_pipe_draw_work);
+    k_work_init(&pipe->publish_work, render_pipe_publish_work);
+    pipe->take = take;
+    pipe->draw = draw;
+    pipe->publish = publish;
+    pipe->busy = false;
+}
+
+bool render_pipe_start(struct render_pipe *pipe) {
+    if (pipe->busy) {
+        stats.busy++;
+        return false;
+    }
+    if (!pipe->take(pipe)) {
+        return false;
+    }
+    pipe->busy = true;
+    k_work_submit_to_queue(&render_q, &pipe->draw_work);
+    return true;
+}
+
+void render_pipe_get_stats(struct render_pipe_stats *out) { *out = stats; }
@@ -0,0 +1,52 @@
+/*
+ * Custom Nice!View render thread pipeline
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+struct render_pipe;
+
+// Display queue: copy the inputs of a frame; false when there is nothing to draw
+typedef bool (*render_pipe_take_fn)(struct render_pipe *pipe);
+// Render thread: draw the taken frame into the back buffer
+typedef void (*render_pipe_draw_fn)(struct render_pipe *pipe);
+// Display queue: make the drawn frame visible
+typedef void (*render_pipe_publish_fn)(struct render_pipe *pipe);
+
+// Moves drawing off the display work queue. A frame is taken on the display
+// queue, drawn on a dedicated lower-priority render thread and published
+// back on the display queue, so LVGL only ever sees complete frames and
+// refreshes and flushes while the next frame is drawn. One frame is in
+// flight at a time; a frame started meanwhile is refused and its regions
+// stay dirty for the owner to request again once the current one is out.
+struct render_pipe {
+    struct k_work draw_work;
+    struct k_work publish_work;
+    render_pipe_take_fn take;
+    render_pipe_draw_fn draw;
+    render_pipe_publish_fn publish;
+    // Set from take until publish returns; only touched on the display queue
+    bool busy;
+};
+
+struct render_pipe_stats {
+    uint32_t frames;
+    // Frames started while the previous one was still in flight
+    uint32_t busy;
+    uint32_t draw_us_last;
+    uint32_t draw_us_max;
+};
+
+// Display queue; starts the render thread on first use
+void render_pipe_init(struct render_pipe *pipe, render_pipe_take_fn take,
+                      render_pipe_draw_fn draw, render_pipe_publish_fn publish);
+// Display queue: take a frame and hand it to the render thread. Returns
+// false when nothing was taken or a frame is already in flight.
+bool render_pipe_start(struct render_pipe *pipe);
+static inline bool render_pipe_busy(const struct render_pipe *pipe) { return pipe->busy; }
+void render_pipe_get_stats(struct render_pipe_stats *stats);
@@ -0,0 +1,92 @@
+/*
+ * Custom Nice!View frame scheduler
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zmk/display.h>
+
+#include "render_sched.h"
+#include "queue_stats.h"
+
+#define FRAME_INTERVAL_MS (1000 / CONFIG_NICE_VIEW_CUSTOM_WIDGET_MAX_FPS)
+
+// Only touched from the display work queue
+static struct render_sched_stats stats;
+
+static void render_sched_work(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct render_sched *sched = CONTAINER_OF(dwork, struct render_sched, work);
+
+    sched->last_frame = k_uptime_get();
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    sched->deferred = false;
+#endif
+    stats.frames++;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_QUEUE_STATS)
+    uint32_t start = k_cycle_get_32();
+    sched->render(sched);
+    queue_stats_render(k_cycle_get_32() - start);
+#else
+    sched->render(sched);
+#endif
+}
+
+void render_sched_init(struct render_sched *sched, render_sched_fn render) {
+    k_work_init_delayable(&sched->work, render_sched_work);
+    sched->last_frame = 0;
+    sched->render = render;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    sched->idle = false;
+    sched->deferred = false;
+#endif
+}
+
+void render_sched_request(struct render_sched *sched) {
+    int64_t interval = FRAME_INTERVAL_MS;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    if (sched->idle) {
+        // A frame is already held back and renders this request too, so
+        // the frame it would have had is the one skipped
+        if (sched->deferred || k_work_delayable_is_pending(&sched->work)) {
+            stats.suppressed++;
+        }
+        if (CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_REFRESH_SEC == 0) {
+            sched->deferred = true;
+            return;
+        }
+        interval = CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_REFRESH_SEC * MSEC_PER_SEC;
+    }
+#endif
+
+    int64_t next = sched->last_frame + interval;
+    int64_t now = k_uptime_get();
+    k_timeout_t delay = next > now ? K_MSEC(next - now) : K_NO_WAIT;
+
+    // Does nothing if a frame is already pending, so a burst of events
+    // collapses into the one frame that renders every dirty region
+    k_work_schedule_for_queue(zmk_display_work_q(), &sched->work, delay);
+}
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+void render_sched_set_idle(struct render_sched *sched, bool idle) {
+    if (sched->idle == idle) {
+        return;
+    }
+    sched->idle = idle;
+
+    // Frames held back at the idle interval are pending work; pull them in
+    if (!idle && (sched->deferred || k_work_delayable_is_pending(&sched->work))) {
+        stats.catchups++;
+        k_work_reschedule_for_queue(zmk_display_work_q(), &sched->work, K_NO_WAIT);
+    }
+}
+
+void render_sched_suppress(struct render_sched *sched) {
+    ARG_UNUSED(sched);
+    stats.suppressed++;
+}
+#endif
+
+void render_sched_get_stats(struct render_sched_stats *out) { *out = stats; }
@@ -0,0 +1,48 @@
+/*
+ * Custom Nice!View frame scheduler
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+struct render_sched;
+
+typedef void (*render_sched_fn)(struct render_sched *sched);
+
+// Coalesces render requests into at most one frame per
+// CONFIG_NICE_VIEW_CUSTOM_WIDGET_MAX_FPS interval, run on the display work queue
+struct render_sched {
+    struct k_work_delayable work;
+    int64_t last_frame;
+    render_sched_fn render;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+    // While idle, frames are held back to the idle refresh interval
+    bool idle;
+    // A request was dropped while idle and still needs a frame
+    bool deferred;
+#endif
+};
+
+struct render_sched_stats {
+    uint32_t frames;
+    // Dirty frames that were never rendered because the keyboard was idle:
+    // requests merged into a frame already held back, and updates dropped
+    // through render_sched_suppress
+    uint32_t suppressed;
+    // Frames rendered right away on the way back from idle
+    uint32_t catchups;
+};
+
+void render_sched_init(struct render_sched *sched, render_sched_fn render);
+void render_sched_request(struct render_sched *sched);
+void render_sched_get_stats(struct render_sched_stats *stats);
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_IDLE_GOVERNOR)
+// Switch between the active frame rate and the idle refresh interval; leaving
+// idle renders whatever was held back immediately
+void render_sched_set_idle(struct render_sched *sched, bool idle);
+// Count an update the caller kept from rendering because the keyboard is idle
+void render_sched_suppress(struct render_sched *sched);
+#endif
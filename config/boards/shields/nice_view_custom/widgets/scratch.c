@@ -0,0 +1,53 @@
+/*
+ * Custom Nice!View render scratch arena
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "scratch.h"
+#include "util.h"
+
+#define SCRATCH_SIZE CONFIG_NICE_VIEW_CUSTOM_WIDGET_SCRATCH_SIZE
+#define SCRATCH_ALIGN 4
+
+static struct {
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+    lv_color_t canvas[CANVAS_SIZE * CANVAS_SIZE];
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+    uint8_t packed[CANVAS_STRIDE_1BPP * CANVAS_SIZE];
+#endif
+#endif
+    uint8_t heap[SCRATCH_SIZE] __aligned(SCRATCH_ALIGN);
+} arena;
+
+// Only touched by whoever is rendering, see scratch.h
+static uint16_t used;
+static struct scratch_stats stats = {.size = SCRATCH_SIZE};
+
+void scratch_reset(void) { used = 0; }
+
+void *scratch_alloc(size_t size) {
+    size_t start = ROUND_UP(used, SCRATCH_ALIGN);
+
+    if (start + size > SCRATCH_SIZE) {
+        if (stats.failures++ == 0) {
+            LOG_WRN("render scratch full: %zu + %zu > %d bytes", start, size, SCRATCH_SIZE);
+        }
+        return NULL;
+    }
+    used = start + size;
+    stats.peak = MAX(stats.peak, used);
+    return &arena.heap[start];
+}
+
+void scratch_get_stats(struct scratch_stats *out) { *out = stats; }
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+lv_color_t *scratch_canvas_buf(void) { return arena.canvas; }
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+uint8_t *scratch_packed_buf(void) { return arena.packed; }
+#endif
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Custom Nice!View render scratch arena
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <lvgl.h>
+
+// Temporary render data lives in one static arena. Regions render one after
+// another, on the display queue or the render thread but never both at once,
+// so region_draw_begin resets it and anything allocated is valid until the
+// next region starts.
+
+struct scratch_stats {
+    uint16_t size;
+    // Most bytes allocated for one region since boot
+    uint16_t peak;
+    // Allocations refused because the arena was full
+    uint32_t failures;
+};
+
+void scratch_reset(void);
+// Returns NULL, and logs once, when the arena cannot fit the allocation
+void *scratch_alloc(size_t size);
+void scratch_get_stats(struct scratch_stats *stats);
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+// Pixels of the shared LVGL scratch canvas, CANVAS_SIZE x CANVAS_SIZE true color
+lv_color_t *scratch_canvas_buf(void);
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+// The scratch canvas packed to 1bpp before rotation. It has its own static
+// buffer rather than arena space, so rotating a region cannot run out.
+uint8_t *scratch_packed_buf(void);
+#endif
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Custom Nice!View full-screen canvas
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "screen_canvas.h"
+
+// Indexed canvases start with their palette, one lv_color32_t per index
+#define SCREEN_PALETTE_SIZE (2 * sizeof(lv_color32_t))
+#define SCREEN_STRIDE ((SCREEN_WIDTH + 7) / 8)
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+#define SCREEN_FRONT(screen) ((screen)->buf[!(screen)->back])
+#define SCREEN_BACK(screen) ((screen)->buf[(screen)->back])
+#else
+#define SCREEN_FRONT(screen) ((screen)->buf)
+#define SCREEN_BACK(screen) ((screen)->buf)
+#endif
+
+lv_obj_t *screen_canvas_init(struct screen_canvas *screen, lv_obj_t *parent) {
+    screen->obj = lv_canvas_create(parent);
+    // No theme styles, and nothing to scroll or click
+    lv_obj_remove_style_all(screen->obj);
+    lv_obj_clear_flag(screen->obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    screen->back = 1;
+    screen->drawn_x0 = SCREEN_WIDTH;
+    screen->drawn_x1 = -1;
+#endif
+    lv_canvas_set_buffer(screen->obj, SCREEN_FRONT(screen), SCREEN_WIDTH, SCREEN_HEIGHT,
+                         LV_IMG_CF_INDEXED_1BIT);
+    lv_canvas_set_palette(screen->obj, 0, LVGL_BACKGROUND);
+    lv_canvas_set_palette(screen->obj, 1, LVGL_FOREGROUND);
+    memset(SCREEN_FRONT(screen) + SCREEN_PALETTE_SIZE, 0, SCREEN_BUF_SIZE - SCREEN_PALETTE_SIZE);
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    // The palette is part of the buffer, so the back buffer needs it too
+    memcpy(SCREEN_BACK(screen), SCREEN_FRONT(screen), SCREEN_BUF_SIZE);
+#endif
+    return screen->obj;
+}
+
+void screen_canvas_region(struct screen_canvas *screen, struct region *region, lv_coord_t x,
+                          lv_coord_t y0, lv_coord_t y1) {
+    region->obj = screen->obj;
+    region->screen = screen;
+    region->y0 = y0;
+    region->y1 = y1;
+    // Logical row y1 - 1 lands on column x
+    region->col0 = x + y1 - CANVAS_SIZE;
+}
+
+struct fb_view screen_canvas_view(const struct region *region) {
+    return (struct fb_view){
+        .buf = SCREEN_BACK(region->screen) + SCREEN_PALETTE_SIZE,
+        .stride = SCREEN_STRIDE,
+        .col0 = region->col0,
+        .y0 = region->y0,
+        .y1 = region->y1,
+    };
+}
+
+void screen_canvas_invalidate(const struct region *region) {
+    lv_coord_t x0 = region->col0 + CANVAS_SIZE - region->y1;
+    lv_coord_t x1 = x0 + region->y1 - region->y0 - 1;
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    struct screen_canvas *screen = region->screen;
+    screen->drawn_x0 = MIN(screen->drawn_x0, x0);
+    screen->drawn_x1 = MAX(screen->drawn_x1, x1);
+#else
+    lv_area_t area;
+    lv_obj_get_coords(region->obj, &area);
+    area.x2 = area.x1 + x1;
+    area.x1 += x0;
+    lv_obj_invalidate_area(region->obj, &area);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+void screen_canvas_publish(struct screen_canvas *screen) {
+    if (screen->drawn_x0 > screen->drawn_x1) {
+        return;
+    }
+
+    // Setting the buffer invalidates the whole canvas. That costs LVGL
+    // redrawing the untouched columns but no extra panel lines: every
+    // window spans all 68 lines, and LS0xx flushes are whole lines anyway.
+    lv_canvas_set_buffer(screen->obj, SCREEN_BACK(screen), SCREEN_WIDTH, SCREEN_HEIGHT,
+                         LV_IMG_CF_INDEXED_1BIT);
+    screen->back = !screen->back;
+
+    // The new back buffer is one frame behind in the drawn columns only;
+    // copy the bytes holding them so the next frame can draw just its
+    // dirty regions on top
+    int b0 = screen->drawn_x0 / 8;
+    int b1 = screen->drawn_x1 / 8;
+    const uint8_t *front = SCREEN_FRONT(screen) + SCREEN_PALETTE_SIZE;
+    uint8_t *back = SCREEN_BACK(screen) + SCREEN_PALETTE_SIZE;
+    for (int row = 0; row < SCREEN_HEIGHT; row++) {
+        memcpy(&back[row * SCREEN_STRIDE + b0], &front[row * SCREEN_STRIDE + b0], b1 - b0 + 1);
+    }
+
+    screen->drawn_x0 = SCREEN_WIDTH;
+    screen->drawn_x1 = -1;
+}
+#endif
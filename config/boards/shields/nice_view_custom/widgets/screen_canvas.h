@@ -0,0 +1,53 @@
+/*
+ * Custom Nice!View full-screen canvas
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "util.h"
+
+#define SCREEN_WIDTH 160
+#define SCREEN_HEIGHT 68
+#define SCREEN_BUF_SIZE LV_CANVAS_BUF_SIZE_INDEXED_1BIT(SCREEN_WIDTH, SCREEN_HEIGHT)
+
+// The whole panel as one style-less canvas with no container, so there is a
+// single object to lay out and draw. Regions are fixed, non-overlapping
+// windows of it and invalidate only their own window. With
+// CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD it is double buffered:
+// regions draw into the back buffer while LVGL shows the front one, and
+// screen_canvas_publish swaps them once a frame is complete.
+struct screen_canvas {
+    lv_obj_t *obj;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+    uint8_t buf[2][SCREEN_BUF_SIZE] __aligned(4);
+    uint8_t back;
+    // Screen columns drawn into the back buffer since the last publish;
+    // drawn_x0 > drawn_x1 when there are none
+    lv_coord_t drawn_x0;
+    lv_coord_t drawn_x1;
+#else
+    uint8_t buf[SCREEN_BUF_SIZE] __aligned(4);
+#endif
+};
+
+lv_obj_t *screen_canvas_init(struct screen_canvas *screen, lv_obj_t *parent);
+
+// Make region the window at screen columns x .. x + y1 - y0 - 1, showing the
+// region's logical rows y0 .. y1 - 1 (row y0 at the right edge)
+void screen_canvas_region(struct screen_canvas *screen, struct region *region, lv_coord_t x,
+                          lv_coord_t y0, lv_coord_t y1);
+
+struct fb_view screen_canvas_view(const struct region *region);
+// Invalidate the region's window; when double buffered, only note it for
+// the next publish, so this is safe off the LVGL thread
+void screen_canvas_invalidate(const struct region *region);
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+// LVGL thread, with nobody drawing: show the back buffer and bring the new
+// back buffer up to date with it. Does nothing when nothing was drawn.
+void screen_canvas_publish(struct screen_canvas *screen);
+#endif
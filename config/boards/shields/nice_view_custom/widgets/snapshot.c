@@ -0,0 +1,130 @@
+/*
+ * Custom Nice!View boot snapshot
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/crc.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "panel_flush.h"
+#include "snapshot.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+#include "flush_async.h"
+#endif
+
+#define SNAPSHOT_KEY "nice_view/snapshot"
+#define SAVE_DELAY K_SECONDS(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT_SAVE_DELAY_SEC)
+#define MIN_INTERVAL_MS (CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT_MIN_INTERVAL_SEC * MSEC_PER_SEC)
+
+// Loaded at boot, then reused as the CRC source for the stored frame and,
+// with ASYNC_FLUSH, for the copy of the shadow being saved
+static uint8_t frame[PANEL_FRAME_SIZE];
+static bool frame_loaded;
+static uint32_t stored_crc;
+static int64_t last_write = -MIN_INTERVAL_MS;
+static struct snapshot_stats stats;
+
+static int snapshot_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                                 void *cb_arg) {
+    // A frame from a panel of another size is just ignored
+    if (len != sizeof(frame)) {
+        return 0;
+    }
+    if (read_cb(cb_arg, frame, sizeof(frame)) != sizeof(frame)) {
+        return -EIO;
+    }
+    frame_loaded = true;
+    stored_crc = crc32_ieee(frame, sizeof(frame));
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(nice_view_snapshot, SNAPSHOT_KEY, NULL, snapshot_settings_set,
+                               NULL, NULL);
+
+static void snapshot_save_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(snapshot_save_work, snapshot_save_work_cb);
+
+// Runs on the display work queue, so the shadow cannot change mid-save
+// unless flushes run on their own thread; then a copy is saved instead
+static void snapshot_save_work_cb(struct k_work *work) {
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+    flush_async_lock();
+    const uint8_t *shadow = panel_flush_frame();
+    if (shadow != NULL) {
+        memcpy(frame, shadow, sizeof(frame));
+    }
+    flush_async_unlock();
+    const uint8_t *current = shadow != NULL ? frame : NULL;
+#else
+    const uint8_t *current = panel_flush_frame();
+#endif
+    if (current == NULL) {
+        return;
+    }
+
+    uint32_t crc = crc32_ieee(current, PANEL_FRAME_SIZE);
+    if (crc == stored_crc) {
+        stats.unchanged++;
+        return;
+    }
+
+    // The minimum interval alone bounds flash wear, however long the
+    // keyboard stays up; further changes are batched into the next write
+    int64_t wait = last_write + MIN_INTERVAL_MS - k_uptime_get();
+    if (wait > 0) {
+        stats.deferred++;
+        k_work_schedule_for_queue(zmk_display_work_q(), &snapshot_save_work, K_MSEC(wait));
+        return;
+    }
+
+    int err = settings_save_one(SNAPSHOT_KEY, current, PANEL_FRAME_SIZE);
+    if (err < 0) {
+        LOG_WRN("snapshot save failed: %d", err);
+        return;
+    }
+    stored_crc = crc;
+    last_write = k_uptime_get();
+    stats.writes++;
+    LOG_DBG("snapshot saved (%u this boot)", stats.writes);
+}
+
+void snapshot_frame_changed(void) {
+    // Every change pushes the save out again, so nothing is written while
+    // the panel keeps changing
+    k_work_reschedule_for_queue(zmk_display_work_q(), &snapshot_save_work, SAVE_DELAY);
+}
+
+void snapshot_get_stats(struct snapshot_stats *out) { *out = stats; }
+
+// Put the stored frame on the panel as soon as the driver is up, well before
+// LVGL and the widgets render the first live frame
+static int snapshot_boot(void) {
+    int err = settings_subsys_init();
+    if (err == 0) {
+        err = settings_load_subtree(SNAPSHOT_KEY);
+    }
+    if (err < 0) {
+        LOG_WRN("snapshot load failed: %d", err);
+        return 0;
+    }
+    if (!frame_loaded) {
+        LOG_INF("no snapshot stored");
+        return 0;
+    }
+
+    err = panel_flush_preload(frame);
+    if (err < 0) {
+        LOG_WRN("snapshot blit failed: %d", err);
+        return 0;
+    }
+    LOG_INF("boot to first pixel (snapshot): %u ms", k_uptime_get_32());
+    return 0;
+}
+
+SYS_INIT(snapshot_boot, APPLICATION, 0);
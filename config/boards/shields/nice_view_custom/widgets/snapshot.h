@@ -0,0 +1,20 @@
+/*
+ * Custom Nice!View boot snapshot
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Called from the panel flush whenever panel content changed; the frame is
+// saved once the panel has been unchanged for the save delay
+void snapshot_frame_changed(void);
+
+struct snapshot_stats {
+    uint32_t writes;
+    // Saves skipped because the frame matched the stored one
+    uint32_t unchanged;
+    // Saves held back until the minimum interval since the last write passed
+    uint32_t deferred;
+};
+
+void snapshot_get_stats(struct snapshot_stats *stats);
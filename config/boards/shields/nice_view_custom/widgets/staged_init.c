@@ -0,0 +1,47 @@
+/*
+ * Custom Nice!View staged widget initialization
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "staged_init.h"
+
+static void run_stage(struct staged_init *init) {
+    const struct init_stage *stage = &init->stages[init->next++];
+    uint32_t start = k_cycle_get_32();
+
+    stage->run(init->data);
+
+    uint32_t end = k_cycle_get_32();
+    LOG_INF("widget init %s: %u us, %u us since start", stage->name,
+            k_cyc_to_us_floor32(end - start), k_cyc_to_us_floor32(end - init->start_cyc));
+}
+
+static void staged_init_work(struct k_work *work) {
+    struct staged_init *init = CONTAINER_OF(work, struct staged_init, work);
+
+    run_stage(init);
+    if (init->next < init->count) {
+        k_work_submit_to_queue(zmk_display_work_q(), &init->work);
+    }
+}
+
+void staged_init_start(struct staged_init *init, const struct init_stage *stages, uint8_t count,
+                       void *data) {
+    init->stages = stages;
+    init->count = count;
+    init->next = 0;
+    init->data = data;
+    init->start_cyc = k_cycle_get_32();
+    k_work_init(&init->work, staged_init_work);
+
+    run_stage(init);
+    if (init->next < init->count) {
+        k_work_submit_to_queue(zmk_display_work_q(), &init->work);
+    }
+}
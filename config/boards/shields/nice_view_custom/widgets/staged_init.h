@@ -0,0 +1,28 @@
+/*
+ * Custom Nice!View staged widget initialization
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+struct init_stage {
+    const char *name;
+    void (*run)(void *data);
+};
+
+// Runs a widget's init stages: the first one synchronously, the rest one per
+// work item on the display work queue, so LVGL can put earlier results on
+// the panel in between. Each stage's duration is logged.
+struct staged_init {
+    struct k_work work;
+    const struct init_stage *stages;
+    uint8_t count;
+    uint8_t next;
+    void *data;
+    uint32_t start_cyc;
+};
+
+void staged_init_start(struct staged_init *init, const struct init_stage *stages, uint8_t count,
+                       void *data);
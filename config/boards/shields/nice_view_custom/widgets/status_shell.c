@@ -0,0 +1,192 @@
+/*
+ * Custom Nice!View shell commands for widget statistics
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "render_sched.h"
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+#include "latency.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+#include "panel_flush.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+#include "text_cache.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+#include "snapshot.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_QUEUE_STATS)
+#include "queue_stats.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_MEM_REPORT)
+#include "mem_report.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+#include "render_pipe.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+#include "flush_async.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_STORM)
+#include "storm.h"
+
+#define STORM_RATE_MAX 10000
+#define STORM_SECONDS_MAX 600
+#endif
+
+static int cmd_frames(const struct shell *sh, size_t argc, char **argv) {
+    struct render_sched_stats stats;
+    render_sched_get_stats(&stats);
+    shell_print(sh, "frames %u suppressed %u catchups %u", stats.frames, stats.suppressed,
+                stats.catchups);
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+static int cmd_render(const struct shell *sh, size_t argc, char **argv) {
+    struct render_pipe_stats stats;
+    render_pipe_get_stats(&stats);
+    shell_print(sh, "frames %u busy %u draw %u us max %u us", stats.frames, stats.busy,
+                stats.draw_us_last, stats.draw_us_max);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+static int cmd_latency(const struct shell *sh, size_t argc, char **argv) {
+    latency_dump(sh);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv) {
+    struct panel_flush_stats stats;
+    panel_flush_get_stats(&stats);
+    shell_print(sh, "flushes %u lines %u/%u bytes %u/%u", stats.flushes, stats.lines_sent,
+                stats.lines_requested, stats.bytes_sent, stats.bytes_requested);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+static int cmd_spi(const struct shell *sh, size_t argc, char **argv) {
+    struct flush_async_stats stats;
+    flush_async_get_stats(&stats);
+    if (stats.flushes == 0) {
+        shell_print(sh, "no flushes yet");
+        return 0;
+    }
+
+    uint32_t avg = stats.busy_us_total / stats.flushes;
+    uint32_t busy_pct = stats.busy_us_total * 100 / (k_uptime_get() * USEC_PER_MSEC);
+    shell_print(sh, "flushes %u busy %u us avg %u us max %u us, %u%% of uptime", stats.flushes,
+                stats.busy_us_last, avg, stats.busy_us_max, busy_pct);
+    // Frames can come no faster than the panel takes them
+    shell_print(sh, "waits %u total %u ms, flush-bound fps %u", stats.waits,
+                (uint32_t)(stats.wait_us_total / USEC_PER_MSEC), avg > 0 ? USEC_PER_SEC / avg : 0);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+static int cmd_text_cache(const struct shell *sh, size_t argc, char **argv) {
+    struct text_cache_stats stats;
+    text_cache_get_stats(&stats);
+    shell_print(sh, "hits %u misses %u evictions %u bypassed %u entries %u bytes %u",
+                stats.hits, stats.misses, stats.evictions, stats.bypassed, stats.entries,
+                stats.bytes_used);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+static int cmd_snapshot(const struct shell *sh, size_t argc, char **argv) {
+    struct snapshot_stats stats;
+    snapshot_get_stats(&stats);
+    shell_print(sh, "writes %u unchanged %u deferred %u", stats.writes, stats.unchanged,
+                stats.deferred);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_QUEUE_STATS)
+static int cmd_queue(const struct shell *sh, size_t argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        queue_stats_reset();
+        return 0;
+    }
+    queue_stats_dump(sh);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_STORM)
+static int cmd_storm(const struct shell *sh, size_t argc, char **argv) {
+    uint32_t rate = strtoul(argv[1], NULL, 10);
+    uint32_t seconds = strtoul(argv[2], NULL, 10);
+
+    if (rate == 0 || rate > STORM_RATE_MAX || seconds == 0 || seconds > STORM_SECONDS_MAX) {
+        shell_error(sh, "rate 1..%d events/s, seconds 1..%d", STORM_RATE_MAX,
+                    STORM_SECONDS_MAX);
+        return -EINVAL;
+    }
+
+    int err = storm_start(rate, seconds);
+    if (err == -EBUSY) {
+        shell_error(sh, "a storm is already running");
+        return err;
+    }
+    shell_print(sh, "storm started, counters are logged when it ends");
+    return err;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_MEM_REPORT)
+static int cmd_mem(const struct shell *sh, size_t argc, char **argv) {
+    mem_report_dump(sh);
+    return 0;
+}
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nice_view,
+                               SHELL_CMD(frames, NULL, "Frame scheduler counters", cmd_frames),
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_RENDER_THREAD)
+                               SHELL_CMD(render, NULL, "Render thread frames", cmd_render),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_LATENCY)
+                               SHELL_CMD(latency, NULL, "Keypress-to-pixel latency", cmd_latency),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PARTIAL_FLUSH)
+                               SHELL_CMD(flush, NULL, "Panel flush line diff", cmd_flush),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_ASYNC_FLUSH)
+                               SHELL_CMD(spi, NULL, "Panel flush busy time", cmd_spi),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+                               SHELL_CMD(text_cache, NULL, "Text sprite cache", cmd_text_cache),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SNAPSHOT)
+                               SHELL_CMD(snapshot, NULL, "Boot snapshot writes", cmd_snapshot),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_QUEUE_STATS)
+                               SHELL_CMD_ARG(queue, NULL, "Display queue backlog [reset]",
+                                             cmd_queue, 1, 1),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_STORM)
+                               SHELL_CMD_ARG(storm, NULL, "WPM event storm <rate> <seconds>",
+                                             cmd_storm, 3, 0),
+#endif
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_MEM_REPORT)
+                               SHELL_CMD(mem, NULL, "Display RAM use", cmd_mem),
+#endif
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(nice_view, &sub_nice_view, "nice!view widget statistics", NULL);
@@ -0,0 +1,84 @@
+/*
+ * Custom Nice!View synthetic event storm
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/wpm_state_changed.h>
+
+#include "queue_stats.h"
+#include "storm.h"
+
+#define STORM_WPM_MAX 150
+#define STORM_TICK_MS 1
+// Events raised per tick at most, so a storm cannot starve the system queue
+#define STORM_BURST_MAX 64
+
+// Only WPM events are raised: nothing but display listeners acts on them.
+// Keycode events would be typed on the host and layer changes would change
+// what the keys do; streams with those replay on the host (host/replay_main.c).
+struct storm {
+    struct k_work_delayable work;
+    uint32_t rate;
+    uint32_t sent;
+    uint32_t total;
+    int64_t start;
+    bool running;
+};
+
+static struct storm storm;
+
+static void storm_raise(uint32_t n) {
+    // Triangle sweep so consecutive samples always differ
+    uint32_t step = n % (2 * STORM_WPM_MAX);
+    uint8_t wpm = step < STORM_WPM_MAX ? step : 2 * STORM_WPM_MAX - step;
+    raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = wpm});
+}
+
+static void storm_finish(void) {
+    int64_t elapsed = k_uptime_get() - storm.start;
+
+    storm.running = false;
+    LOG_INF("storm: %u events in %lld ms", storm.sent, elapsed);
+    queue_stats_dump(NULL);
+}
+
+static void storm_work_cb(struct k_work *work) {
+    int64_t elapsed = k_uptime_get() - storm.start;
+    uint32_t due = MIN((uint64_t)storm.rate * elapsed / MSEC_PER_SEC, storm.total);
+    uint32_t burst = MIN(due - storm.sent, STORM_BURST_MAX);
+
+    for (uint32_t i = 0; i < burst; i++) {
+        storm_raise(storm.sent++);
+    }
+
+    if (storm.sent >= storm.total) {
+        storm_finish();
+        return;
+    }
+    k_work_schedule(&storm.work, K_MSEC(STORM_TICK_MS));
+}
+
+int storm_start(uint32_t rate, uint32_t seconds) {
+    if (storm.running) {
+        return -EBUSY;
+    }
+    if (rate == 0 || seconds == 0) {
+        return -EINVAL;
+    }
+
+    k_work_init_delayable(&storm.work, storm_work_cb);
+    storm.rate = rate;
+    storm.sent = 0;
+    storm.total = rate * seconds;
+    storm.running = true;
+
+    queue_stats_reset();
+    storm.start = k_uptime_get();
+    k_work_schedule(&storm.work, K_NO_WAIT);
+    return 0;
+}
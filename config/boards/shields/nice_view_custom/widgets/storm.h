@@ -0,0 +1,13 @@
+/*
+ * Custom Nice!View synthetic event storm
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Raise `rate` WPM events per second for `seconds`, sweeping 0..150 so every
+// event is a graph update, starting from zeroed queue counters, and log the
+// counters when done. Returns -EBUSY while a storm runs.
+int storm_start(uint32_t rate, uint32_t seconds);
@@ -0,0 +1,197 @@
+/*
+ * Custom Nice!View text sprite cache
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "text_cache.h"
+
+#define CACHE_BYTES CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE_SIZE
+#define CACHE_ENTRIES 32
+#define CACHE_TEXT_LEN 15
+
+struct text_cache_entry {
+    const lv_font_t *font;
+    char text[CACHE_TEXT_LEN + 1];
+    uint32_t last_used;
+    uint16_t offset;
+    uint16_t size;
+    struct text_sprite sprite;
+};
+
+// Sprites are packed back to back in the arena; evicting one compacts the
+// ones after it, so free space is always at the end
+static uint8_t arena[CACHE_BYTES] __aligned(4);
+static uint16_t arena_used;
+static struct text_cache_entry entries[CACHE_ENTRIES];
+static uint8_t entry_count;
+static uint32_t use_clock;
+static struct text_cache_stats stats;
+
+static uint8_t glyph_px(const uint8_t *bitmap, uint8_t bpp, uint32_t index) {
+    uint32_t bit = index * bpp;
+    return (bitmap[bit / 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1);
+}
+
+static uint16_t text_width(const lv_font_t *font, const char *text) {
+    uint32_t i = 0;
+    uint16_t w = 0;
+    uint32_t letter = _lv_txt_encoded_next(text, &i);
+    while (letter != 0) {
+        uint32_t next = _lv_txt_encoded_next(text, &i);
+        w += lv_font_get_glyph_width(font, letter, next);
+        letter = next;
+    }
+    return w;
+}
+
+// Rasterize glyphs the way LVGL blends them at 1-bit color depth: a pixel is
+// set when its coverage is above 50%
+static void rasterize(const lv_font_t *font, const char *text, uint8_t *bits, uint16_t stride) {
+    uint32_t i = 0;
+    lv_coord_t pen = 0;
+    uint32_t letter = _lv_txt_encoded_next(text, &i);
+
+    while (letter != 0) {
+        uint32_t next = _lv_txt_encoded_next(text, &i);
+        lv_font_glyph_dsc_t g;
+
+        if (lv_font_get_glyph_dsc(font, &g, letter, next)) {
+            const lv_font_t *glyph_font = g.resolved_font != NULL ? g.resolved_font : font;
+            const uint8_t *bitmap = lv_font_get_glyph_bitmap(glyph_font, letter);
+            uint8_t max = (1 << g.bpp) - 1;
+            lv_coord_t gx = pen + g.ofs_x;
+            lv_coord_t gy = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+
+            for (int row = 0; bitmap != NULL && row < g.box_h; row++) {
+                lv_coord_t py = gy + row;
+                if (py < 0 || py >= font->line_height) {
+                    continue;
+                }
+                for (int col = 0; col < g.box_w; col++) {
+                    lv_coord_t px = gx + col;
+                    if (px < 0 || px >= stride * 8) {
+                        continue;
+                    }
+                    if (glyph_px(bitmap, g.bpp, row * g.box_w + col) * 2 > max) {
+                        bits[py * stride + px / 8] |= BIT(7 - px % 8);
+                    }
+                }
+            }
+            pen += g.adv_w;
+        }
+        letter = next;
+    }
+}
+
+static void evict_lru(void) {
+    int lru = 0;
+    for (int i = 1; i < entry_count; i++) {
+        if (entries[i].last_used < entries[lru].last_used) {
+            lru = i;
+        }
+    }
+
+    uint16_t offset = entries[lru].offset;
+    uint16_t size = entries[lru].size;
+    memmove(&arena[offset], &arena[offset + size], arena_used - offset - size);
+    arena_used -= size;
+
+    entries[lru] = entries[--entry_count];
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].offset > offset) {
+            entries[i].offset -= size;
+        }
+        entries[i].sprite.bits = &arena[entries[i].offset];
+    }
+    stats.evictions++;
+}
+
+const struct text_sprite *text_cache_get(const lv_font_t *font, const char *text) {
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].font == font && strcmp(entries[i].text, text) == 0) {
+            entries[i].last_used = ++use_clock;
+            stats.hits++;
+            return &entries[i].sprite;
+        }
+    }
+
+    uint16_t w = text_width(font, text);
+    uint16_t stride = DIV_ROUND_UP(w, 8);
+    uint32_t size = ROUND_UP(stride * font->line_height, 4);
+    if (strlen(text) > CACHE_TEXT_LEN || w == 0 || size > CACHE_BYTES) {
+        return NULL;
+    }
+
+    while (entry_count == CACHE_ENTRIES || arena_used + size > CACHE_BYTES) {
+        evict_lru();
+    }
+
+    struct text_cache_entry *entry = &entries[entry_count++];
+    entry->font = font;
+    strcpy(entry->text, text);
+    entry->last_used = ++use_clock;
+    entry->offset = arena_used;
+    entry->size = size;
+    entry->sprite = (struct text_sprite){
+        .w = w,
+        .h = font->line_height,
+        .stride = stride,
+        .bits = &arena[arena_used],
+    };
+
+    memset(&arena[arena_used], 0, size);
+    rasterize(font, text, &arena[arena_used], stride);
+    arena_used += size;
+
+    stats.misses++;
+    LOG_DBG("text cache miss \"%s\": %ux%u, %u/%u bytes used", text, w, entry->sprite.h,
+            arena_used, CACHE_BYTES);
+    return &entry->sprite;
+}
+
+void text_cache_draw(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                     const lv_draw_label_dsc_t *dsc, const char *text) {
+    const struct text_sprite *sprite = text_cache_get(dsc->font, text);
+    if (sprite == NULL) {
+        stats.bypassed++;
+        lv_canvas_draw_text(canvas, x, y, max_w, (lv_draw_label_dsc_t *)dsc, text);
+        return;
+    }
+
+    lv_img_dsc_t *img = lv_canvas_get_img(canvas);
+    lv_color_t *buf = (lv_color_t *)img->data;
+    lv_coord_t x0 = x;
+    if (dsc->align == LV_TEXT_ALIGN_CENTER) {
+        x0 += (max_w - sprite->w) / 2;
+    } else if (dsc->align == LV_TEXT_ALIGN_RIGHT) {
+        x0 += max_w - sprite->w;
+    }
+
+    lv_coord_t col_start = MAX(0, MAX(x, 0) - x0);
+    lv_coord_t col_end = MIN(sprite->w, MIN(x + max_w, img->header.w) - x0);
+
+    for (int row = 0; row < sprite->h; row++) {
+        lv_coord_t py = y + row;
+        if (py < 0 || py >= img->header.h) {
+            continue;
+        }
+        const uint8_t *bits = &sprite->bits[row * sprite->stride];
+        lv_color_t *line = &buf[py * img->header.w];
+        for (int col = col_start; col < col_end; col++) {
+            if (bits[col / 8] & BIT(7 - col % 8)) {
+                line[x0 + col] = dsc->color;
+            }
+        }
+    }
+}
+
+void text_cache_get_stats(struct text_cache_stats *out) {
+    *out = stats;
+    out->bytes_used = arena_used;
+    out->entries = entry_count;
+}
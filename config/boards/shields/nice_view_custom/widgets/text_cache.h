@@ -0,0 +1,37 @@
+/*
+ * Custom Nice!View text sprite cache
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+// A line of text rasterized once at 1bpp, MSB first, 1 = glyph ink
+struct text_sprite {
+    uint16_t w;
+    uint16_t h;
+    uint16_t stride;
+    const uint8_t *bits;
+};
+
+struct text_cache_stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    // Texts drawn through LVGL because they could not be cached
+    uint32_t bypassed;
+    uint16_t bytes_used;
+    uint16_t entries;
+};
+
+// Look up (or rasterize and insert) the sprite for a text in a font.
+// Returns NULL if it cannot be cached, e.g. when it exceeds the budget.
+const struct text_sprite *text_cache_get(const lv_font_t *font, const char *text);
+
+// Draw text like lv_canvas_draw_text, from the cache when possible. Text is
+// placed per dsc->align inside max_w and clipped to it instead of wrapping.
+void text_cache_draw(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                     const lv_draw_label_dsc_t *dsc, const char *text);
+
+void text_cache_get_stats(struct text_cache_stats *stats);
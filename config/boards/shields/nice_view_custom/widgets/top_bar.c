@@ -0,0 +1,386 @@
+/*
+ * Custom Nice!View top bar: battery and connection status
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/battery.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#include <zmk/usb.h>
+
+#if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include <zmk/ble.h>
+#include <zmk/endpoints.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#else
+#include <zmk/split/bluetooth/peripheral.h>
+#include <zmk/events/split_peripheral_status_changed.h>
+#endif
+
+#include "latency.h"
+#include "queue_stats.h"
+#include "top_bar.h"
+#include "nv_assets.h"
+
+static sys_slist_t bars = SYS_SLIST_STATIC_INIT(&bars);
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+// Peripheral battery row below the local one, marked by a label right of
+// the battery so the two rows can be told apart
+#define PERIPHERAL_BATTERY_Y 20
+#define PERIPHERAL_BATTERY_LABEL "P"
+#define PERIPHERAL_BATTERY_LABEL_X 33
+#define PERIPHERAL_BATTERY_LABEL_W 12
+#endif
+
+static void mark_dirty(struct top_bar *bar) {
+    bar->state->dirty |= STATUS_REGION_TOP;
+    render_sched_request(bar->sched);
+}
+
+#if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+
+static void connection_text(const struct status_state *state, char *text, size_t len) {
+    switch (state->selected_endpoint.transport) {
+    case ZMK_TRANSPORT_USB:
+        snprintf(text, len, "%s", LV_SYMBOL_USB);
+        break;
+    case ZMK_TRANSPORT_BLE:
+        if (state->active_profile_bonded) {
+            snprintf(text, len, "%s %d",
+                     state->active_profile_connected ? LV_SYMBOL_WIFI : LV_SYMBOL_CLOSE,
+                     state->active_profile_index + 1);
+        } else {
+            snprintf(text, len, "%s", LV_SYMBOL_SETTINGS);
+        }
+        break;
+    }
+}
+
+struct connection_state {
+    struct zmk_endpoint_instance selected_endpoint;
+    int active_profile_index;
+    bool active_profile_connected;
+    bool active_profile_bonded;
+};
+
+static struct connection_state connection_query(void) {
+    return (struct connection_state){
+        .selected_endpoint = zmk_endpoints_selected(),
+        .active_profile_index = zmk_ble_active_profile_index(),
+        .active_profile_connected = zmk_ble_active_profile_is_connected(),
+        .active_profile_bonded = !zmk_ble_active_profile_is_open(),
+    };
+}
+
+static bool set_connection(struct status_state *state, const struct connection_state *conn) {
+    if (zmk_endpoint_instance_eq(state->selected_endpoint, conn->selected_endpoint) &&
+        state->active_profile_index == conn->active_profile_index &&
+        state->active_profile_connected == conn->active_profile_connected &&
+        state->active_profile_bonded == conn->active_profile_bonded) {
+        return false;
+    }
+    state->selected_endpoint = conn->selected_endpoint;
+    state->active_profile_index = conn->active_profile_index;
+    state->active_profile_connected = conn->active_profile_connected;
+    state->active_profile_bonded = conn->active_profile_bonded;
+    return true;
+}
+
+#else
+
+static void connection_text(const struct status_state *state, char *text, size_t len) {
+    snprintf(text, len, "%s", state->connected ? LV_SYMBOL_WIFI : LV_SYMBOL_CLOSE);
+}
+
+struct connection_state {
+    bool connected;
+};
+
+static struct connection_state connection_query(void) {
+    return (struct connection_state){.connected = zmk_split_bt_peripheral_is_connected()};
+}
+
+static bool set_connection(struct status_state *state, const struct connection_state *conn) {
+    if (state->connected == conn->connected) {
+        return false;
+    }
+    state->connected = conn->connected;
+    return true;
+}
+
+#endif
+
+// Battery outline with fill level and the percentage inside, its top at y
+static void draw_battery(const struct region_draw *draw, lv_coord_t y, uint8_t level,
+                         const lv_draw_label_dsc_t *label_dsc) {
+    bool known = level <= 100;
+
+    region_fill_rect(draw, 0, y + 2, 29, 12, LVGL_FOREGROUND);
+    region_fill_rect(draw, 1, y + 3, 27, 10, LVGL_BACKGROUND);
+    if (known) {
+        region_fill_rect(draw, 2, y + 4, (level * 25) / 100, 8, LVGL_FOREGROUND);
+    }
+    region_fill_rect(draw, 29, y + 4, 3, 6, LVGL_FOREGROUND);
+    region_fill_rect(draw, 30, y + 5, 1, 4, LVGL_BACKGROUND);
+
+    char text[5];
+    if (known) {
+        snprintf(text, sizeof(text), "%d", level);
+    } else {
+        snprintf(text, sizeof(text), "-");
+    }
+    region_draw_text(draw, 0, y, 29, label_dsc, text);
+}
+
+void top_bar_draw(const struct top_bar *bar, const struct status_state *state) {
+    struct region_draw draw;
+    region_draw_begin(&draw, bar->region);
+
+    const lv_draw_label_dsc_t *label_dsc =
+        get_label_dsc(WIDGET_FONT_14, LVGL_FOREGROUND, LV_TEXT_ALIGN_CENTER);
+    const lv_draw_label_dsc_t *label_dsc_right =
+        get_label_dsc(WIDGET_FONT_16, LVGL_FOREGROUND, LV_TEXT_ALIGN_RIGHT);
+
+    region_fill_rect(&draw, 0, 0, CANVAS_SIZE, CANVAS_SIZE, LVGL_BACKGROUND);
+
+    // Connection status (top right, draw first so battery can overlap if needed)
+    char conn_text[10] = {};
+    connection_text(state, conn_text, sizeof(conn_text));
+    region_draw_text(&draw, 40, 0, CANVAS_SIZE - 42, label_dsc_right, conn_text);
+
+    draw_battery(&draw, 0, state->battery, label_dsc);
+
+    // Charging bolt
+    if (state->charging) {
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+        fb_blit(&draw.fb, 9, -1, &bolt_sprite);
+#else
+        region_draw_img(&draw, 9, -1, &bolt);
+#endif
+    }
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+    draw_battery(&draw, PERIPHERAL_BATTERY_Y, state->peripheral_battery, label_dsc);
+    region_draw_text(&draw, PERIPHERAL_BATTERY_LABEL_X, PERIPHERAL_BATTERY_Y,
+                     PERIPHERAL_BATTERY_LABEL_W, label_dsc, PERIPHERAL_BATTERY_LABEL);
+#endif
+
+    region_draw_end(&draw);
+}
+
+// Event handlers
+static void set_battery_status(struct top_bar *bar, struct battery_status_state state) {
+    struct status_state *current = bar->state;
+    bool charging = current->charging;
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+    charging = state.usb_present;
+#endif
+    if (current->battery == state.level && current->charging == charging) {
+        return;
+    }
+    current->charging = charging;
+    current->battery = state.level;
+    mark_dirty(bar);
+}
+
+static void battery_status_update_cb(struct battery_status_state state) {
+    queue_stats_run(QUEUE_LISTENER_BATTERY);
+    struct top_bar *bar;
+    SYS_SLIST_FOR_EACH_CONTAINER(&bars, bar, node) {
+        set_battery_status(bar, state);
+        latency_update(STATUS_REGION_TOP, bar->state->dirty);
+    }
+}
+
+static struct battery_status_state battery_status_get_state(const zmk_event_t *eh) {
+    if (eh != NULL) {
+        latency_event(STATUS_REGION_TOP);
+        queue_stats_event(QUEUE_LISTENER_BATTERY);
+    }
+    return (struct battery_status_state){
+        .level = zmk_battery_state_of_charge(),
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+        .usb_present = zmk_usb_is_powered(),
+#endif
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_battery_status, struct battery_status_state,
+                            battery_status_update_cb, battery_status_get_state)
+ZMK_SUBSCRIPTION(widget_battery_status, zmk_battery_state_changed);
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+ZMK_SUBSCRIPTION(widget_battery_status, zmk_usb_conn_state_changed);
+#endif
+
+static void connection_update_cb(struct connection_state state) {
+    queue_stats_run(QUEUE_LISTENER_CONNECTION);
+    struct top_bar *bar;
+    SYS_SLIST_FOR_EACH_CONTAINER(&bars, bar, node) {
+        if (set_connection(bar->state, &state)) {
+            mark_dirty(bar);
+        }
+        latency_update(STATUS_REGION_TOP, bar->state->dirty);
+    }
+}
+
+static struct connection_state connection_get_state(const zmk_event_t *eh) {
+    if (eh != NULL) {
+        latency_event(STATUS_REGION_TOP);
+        queue_stats_event(QUEUE_LISTENER_CONNECTION);
+    }
+    return connection_query();
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_connection_status, struct connection_state,
+                            connection_update_cb, connection_get_state)
+#if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+ZMK_SUBSCRIPTION(widget_connection_status, zmk_endpoint_changed);
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+ZMK_SUBSCRIPTION(widget_connection_status, zmk_usb_conn_state_changed);
+#endif
+ZMK_SUBSCRIPTION(widget_connection_status, zmk_ble_active_profile_changed);
+#else
+ZMK_SUBSCRIPTION(widget_connection_status, zmk_split_peripheral_status_changed);
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+// Levels from the split central's battery fetching are filtered before they
+// reach the screen: changes smaller than the hysteresis are ignored, and at
+// most one change is drawn per minimum interval, the latest one winning.
+struct peripheral_battery_filter {
+    int64_t last_applied;
+    uint8_t shown;
+    uint8_t pending;
+};
+
+static struct peripheral_battery_filter peripheral_filter = {
+    .shown = PERIPHERAL_BATTERY_UNKNOWN,
+    .pending = PERIPHERAL_BATTERY_UNKNOWN,
+};
+
+static void peripheral_battery_apply_work(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(peripheral_battery_work, peripheral_battery_apply_work);
+
+static bool peripheral_battery_significant(uint8_t shown, uint8_t level) {
+    if (shown == PERIPHERAL_BATTERY_UNKNOWN) {
+        return true;
+    }
+    // Always show reaching full or empty, however small the step
+    if (level != shown && (level == 100 || level == 0)) {
+        return true;
+    }
+    int delta = level > shown ? level - shown : shown - level;
+    return delta >= CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY_HYSTERESIS;
+}
+
+static void peripheral_battery_apply(uint8_t level) {
+    peripheral_filter.shown = level;
+    peripheral_filter.pending = PERIPHERAL_BATTERY_UNKNOWN;
+    peripheral_filter.last_applied = k_uptime_get();
+
+    struct top_bar *bar;
+    SYS_SLIST_FOR_EACH_CONTAINER(&bars, bar, node) {
+        bar->state->peripheral_battery = level;
+        mark_dirty(bar);
+    }
+}
+
+static void peripheral_battery_apply_work(struct k_work *work) {
+    uint8_t level = peripheral_filter.pending;
+    if (level != PERIPHERAL_BATTERY_UNKNOWN &&
+        peripheral_battery_significant(peripheral_filter.shown, level)) {
+        peripheral_battery_apply(level);
+    }
+}
+
+struct peripheral_battery_state {
+    uint8_t level;
+};
+
+static void peripheral_battery_filter_level(uint8_t level) {
+    if (!peripheral_battery_significant(peripheral_filter.shown, level)) {
+        // Back within the hysteresis band: drop a change still waiting too
+        peripheral_filter.pending = PERIPHERAL_BATTERY_UNKNOWN;
+        return;
+    }
+
+    int64_t interval = CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY_MIN_INTERVAL_SEC *
+                       MSEC_PER_SEC;
+    int64_t next = peripheral_filter.last_applied + interval;
+    int64_t now = k_uptime_get();
+    if (peripheral_filter.shown == PERIPHERAL_BATTERY_UNKNOWN || next <= now) {
+        peripheral_battery_apply(level);
+        return;
+    }
+
+    // Does nothing if already scheduled; the latest level is applied then
+    peripheral_filter.pending = level;
+    k_work_schedule_for_queue(zmk_display_work_q(), &peripheral_battery_work, K_MSEC(next - now));
+}
+
+static void peripheral_battery_update_cb(struct peripheral_battery_state state) {
+    queue_stats_run(QUEUE_LISTENER_PERIPHERAL_BATTERY);
+    if (state.level != PERIPHERAL_BATTERY_UNKNOWN) {
+        peripheral_battery_filter_level(state.level);
+    }
+
+    struct top_bar *bar;
+    SYS_SLIST_FOR_EACH_CONTAINER(&bars, bar, node) {
+        latency_update(STATUS_REGION_TOP, bar->state->dirty);
+    }
+}
+
+// Latest level of the first peripheral, the only one with a row. Every
+// event overwrites the listener's state before its work runs, so events
+// from other peripherals hand on this level rather than an unknown one,
+// which would drop a level still waiting to be drawn; filtering the same
+// level again changes nothing.
+static uint8_t peripheral_battery_level = PERIPHERAL_BATTERY_UNKNOWN;
+
+static struct peripheral_battery_state peripheral_battery_get_state(const zmk_event_t *eh) {
+    const struct zmk_peripheral_battery_state_changed *ev =
+        eh != NULL ? as_zmk_peripheral_battery_state_changed(eh) : NULL;
+    if (ev != NULL) {
+        // Counted either way, the work item runs either way
+        queue_stats_event(QUEUE_LISTENER_PERIPHERAL_BATTERY);
+        if (ev->source == 0) {
+            latency_event(STATUS_REGION_TOP);
+            peripheral_battery_level = MIN(ev->state_of_charge, 100);
+        }
+    }
+    return (struct peripheral_battery_state){.level = peripheral_battery_level};
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_peripheral_battery, struct peripheral_battery_state,
+                            peripheral_battery_update_cb, peripheral_battery_get_state)
+ZMK_SUBSCRIPTION(widget_peripheral_battery, zmk_peripheral_battery_state_changed);
+#endif
+
+void top_bar_init(struct top_bar *bar, const struct region *region, struct status_state *state,
+                  struct render_sched *sched) {
+    bar->region = region;
+    bar->state = state;
+    bar->sched = sched;
+
+    struct connection_state conn = connection_query();
+    set_connection(state, &conn);
+    state->battery = zmk_battery_state_of_charge();
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+    state->peripheral_battery = peripheral_filter.shown;
+#endif
+
+    sys_slist_append(&bars, &bar->node);
+    widget_battery_status_init();
+    widget_connection_status_init();
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+    widget_peripheral_battery_init();
+#endif
+}
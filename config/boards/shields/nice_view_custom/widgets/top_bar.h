@@ -0,0 +1,31 @@
+/*
+ * Custom Nice!View top bar: battery and connection status
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "render_sched.h"
+#include "util.h"
+
+// The battery and connection region shared by both halves. The connection
+// indicator is picked at compile time: endpoint and BLE profile on the
+// central, split link state on the peripheral.
+struct top_bar {
+    sys_snode_t node;
+    const struct region *region;
+    // The owning widget's state and scheduler; the bar updates the top
+    // region fields and dirty bit and requests frames through them
+    struct status_state *state;
+    struct render_sched *sched;
+};
+
+// Query the initial battery and connection state and start listening
+void top_bar_init(struct top_bar *bar, const struct region *region, struct status_state *state,
+                  struct render_sched *sched);
+// Draw the top region from state, normally the bar's own; the render thread
+// passes its copy of the frame's inputs instead
+void top_bar_draw(const struct top_bar *bar, const struct status_state *state);
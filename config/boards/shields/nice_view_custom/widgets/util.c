@@ -5,23 +5,240 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
 #include "util.h"
+#include "scratch.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+#include "fb.h"
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+#include "screen_canvas.h"
+#endif
+#elif IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+#include "text_cache.h"
+#endif
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+// All regions draw into this canvas one after another; rotate_canvas then
+// moves the result into the region's own buffer
+static lv_obj_t *scratch;
+
+lv_obj_t *scratch_canvas(void) {
+    if (scratch == NULL) {
+        scratch = lv_canvas_create(lv_layer_sys());
+        lv_obj_add_flag(scratch, LV_OBJ_FLAG_HIDDEN);
+        lv_canvas_set_buffer(scratch, scratch_canvas_buf(), CANVAS_SIZE, CANVAS_SIZE,
+                             LV_IMG_CF_TRUE_COLOR);
+    }
+    return scratch;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+
+#define CANVAS_BLOCKS_1BPP CANVAS_STRIDE_1BPP
+// Indexed canvases start with their palette, one lv_color32_t per index
+#define CANVAS_PALETTE_SIZE (2 * sizeof(lv_color32_t))
+
+// Transpose an 8x8 bit matrix held as 8 row bytes, row 0 in the top byte
+static inline uint64_t transpose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+// Rotate a packed 1bpp canvas 90 degrees clockwise, dst[r][c] = src[N - 1 - c][r].
+// That is the transpose of the vertically flipped source, done in 8x8 blocks;
+// rows past the canvas edge read as zero and are never written.
+void rotate_1bpp(const uint8_t *src, uint8_t *dst) {
+    for (int bi = 0; bi < CANVAS_BLOCKS_1BPP; bi++) {
+        for (int bj = 0; bj < CANVAS_BLOCKS_1BPP; bj++) {
+            uint64_t x = 0;
+            for (int k = 0; k < 8; k++) {
+                int row = CANVAS_SIZE - 1 - (bi * 8 + k);
+                uint8_t byte = row >= 0 ? src[row * CANVAS_STRIDE_1BPP + bj] : 0;
+                x |= (uint64_t)byte << (56 - 8 * k);
+            }
+
+            x = transpose8(x);
+
+            for (int k = 0; k < 8; k++) {
+                int row = bj * 8 + k;
+                if (row >= CANVAS_SIZE) {
+                    break;
+                }
+                dst[row * CANVAS_STRIDE_1BPP + bi] = (uint8_t)(x >> (56 - 8 * k));
+            }
+        }
+    }
+}
+
+void pack_1bpp(const lv_color_t *cbuf, uint8_t *packed) {
+    lv_color_t bg = LVGL_BACKGROUND;
+    for (int y = 0; y < CANVAS_SIZE; y++) {
+        const lv_color_t *px = &cbuf[y * CANVAS_SIZE];
+        uint8_t *row = &packed[y * CANVAS_STRIDE_1BPP];
+        for (int b = 0; b < CANVAS_STRIDE_1BPP; b++) {
+            uint8_t byte = 0;
+            for (int k = 0; k < 8; k++) {
+                int x = b * 8 + k;
+                byte = (byte << 1) | (x < CANVAS_SIZE && px[x].full != bg.full);
+            }
+            row[b] = byte;
+        }
+    }
+}
+
+void init_canvas(lv_obj_t *canvas, uint8_t cbuf[]) {
+    lv_canvas_set_buffer(canvas, cbuf, CANVAS_SIZE, CANVAS_SIZE, CANVAS_COLOR_FORMAT);
+    lv_canvas_set_palette(canvas, 0, LVGL_BACKGROUND);
+    lv_canvas_set_palette(canvas, 1, LVGL_FOREGROUND);
+}
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+// Pack the scratch canvas and rotate it straight into the region's 1bpp
+// pixel data, which follows the palette
+void rotate_canvas(lv_obj_t *canvas, uint8_t cbuf[]) {
+    uint8_t *packed = scratch_packed_buf();
 
-void rotate_canvas(lv_obj_t *canvas, lv_color_t cbuf[]) {
-    static lv_color_t temp[CANVAS_SIZE * CANVAS_SIZE];
-    memcpy(temp, cbuf, sizeof(temp));
+    pack_1bpp(scratch_canvas_buf(), packed);
+    rotate_1bpp(packed, cbuf + CANVAS_PALETTE_SIZE);
+    lv_obj_invalidate(canvas);
+}
+#endif
+
+#else
+
+void init_canvas(lv_obj_t *canvas, uint8_t cbuf[]) {
+    lv_canvas_set_buffer(canvas, cbuf, CANVAS_SIZE, CANVAS_SIZE, CANVAS_COLOR_FORMAT);
+}
+
+void rotate_canvas(lv_obj_t *canvas, uint8_t cbuf[]) {
     lv_img_dsc_t img = {
         .header.w = CANVAS_SIZE,
         .header.h = CANVAS_SIZE,
         .data_size = CANVAS_SIZE * CANVAS_SIZE * sizeof(lv_color_t),
         .header.cf = LV_IMG_CF_TRUE_COLOR,
-        .data = (void *)temp,
+        .data = (void *)scratch_canvas_buf(),
     };
     lv_canvas_fill_bg(canvas, LVGL_BACKGROUND, LV_OPA_COVER);
     lv_canvas_transform(canvas, &img, 900, LV_IMG_ZOOM_NONE, -1, 0, CANVAS_SIZE / 2,
                         CANVAS_SIZE / 2, true);
 }
 
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+
+static inline bool is_ink(lv_color_t color) { return color.full != LVGL_BACKGROUND.full; }
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+void region_draw_begin(struct region_draw *draw, const struct region *region) {
+    scratch_reset();
+    draw->region = region;
+    draw->fb = screen_canvas_view(region);
+}
+
+void region_draw_end(struct region_draw *draw) { screen_canvas_invalidate(draw->region); }
+#else
+void region_draw_begin(struct region_draw *draw, const struct region *region) {
+    scratch_reset();
+    draw->region = region;
+    draw->fb = fb_view_region(region->cbuf + CANVAS_PALETTE_SIZE);
+}
+
+void region_draw_end(struct region_draw *draw) { lv_obj_invalidate(draw->region->obj); }
+#endif
+
+void region_fill_rect(const struct region_draw *draw, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                      lv_coord_t h, lv_color_t color) {
+    fb_fill_rect(&draw->fb, x, y, w, h, is_ink(color));
+}
+
+void region_draw_text(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                      lv_coord_t max_w, const lv_draw_label_dsc_t *dsc, const char *text) {
+    fb_draw_text(&draw->fb, x, y, max_w, dsc->font, dsc->align, is_ink(dsc->color), text);
+}
+
+void region_draw_line(const struct region_draw *draw, const lv_point_t *points, uint16_t count,
+                      const lv_draw_line_dsc_t *dsc) {
+    fb_draw_line(&draw->fb, points, count, dsc->width, is_ink(dsc->color));
+}
+
+void region_draw_img(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                     const lv_img_dsc_t *img) {
+    fb_draw_img(&draw->fb, x, y, img);
+}
+
+#else
+
+void region_draw_begin(struct region_draw *draw, const struct region *region) {
+    scratch_reset();
+    draw->region = region;
+    draw->canvas = scratch_canvas();
+}
+
+void region_draw_end(struct region_draw *draw) {
+    rotate_canvas(draw->region->obj, draw->region->cbuf);
+}
+
+void region_fill_rect(const struct region_draw *draw, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                      lv_coord_t h, lv_color_t color) {
+    lv_canvas_draw_rect(draw->canvas, x, y, w, h, get_rect_dsc(color));
+}
+
+void region_draw_text(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                      lv_coord_t max_w, const lv_draw_label_dsc_t *dsc, const char *text) {
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_TEXT_CACHE)
+    text_cache_draw(draw->canvas, x, y, max_w, dsc, text);
+#else
+    lv_canvas_draw_text(draw->canvas, x, y, max_w, (lv_draw_label_dsc_t *)dsc, text);
+#endif
+}
+
+void region_draw_line(const struct region_draw *draw, const lv_point_t *points, uint16_t count,
+                      const lv_draw_line_dsc_t *dsc) {
+    lv_canvas_draw_line(draw->canvas, points, count, (lv_draw_line_dsc_t *)dsc);
+}
+
+void region_draw_img(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                     const lv_img_dsc_t *img) {
+    static lv_draw_img_dsc_t img_dsc;
+    static bool img_dsc_ready;
+    if (!img_dsc_ready) {
+        lv_draw_img_dsc_init(&img_dsc);
+        img_dsc_ready = true;
+    }
+    lv_canvas_draw_img(draw->canvas, x, y, img, &img_dsc);
+}
+
+#endif
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+void region_init_canvas(struct region *region, lv_obj_t *canvas, uint8_t cbuf[]) {
+    init_canvas(canvas, cbuf);
+    region->obj = canvas;
+    region->cbuf = cbuf;
+}
+#endif
+
+void draw_placeholder(const struct region *region) {
+    struct region_draw draw;
+    region_draw_begin(&draw, region);
+    region_fill_rect(&draw, 0, 0, CANVAS_SIZE, CANVAS_SIZE, LVGL_BACKGROUND);
+    for (int i = 0; i < 3; i++) {
+        region_fill_rect(&draw, CANVAS_SIZE / 2 - 7 + i * 6, CANVAS_SIZE / 2 - 1, 2, 2,
+                         LVGL_FOREGROUND);
+    }
+    region_draw_end(&draw);
+}
+
 void init_label_dsc(lv_draw_label_dsc_t *label_dsc, lv_color_t color, const lv_font_t *font,
                     lv_text_align_t align) {
     lv_draw_label_dsc_init(label_dsc);
@@ -40,3 +257,74 @@ void init_line_dsc(lv_draw_line_dsc_t *line_dsc, lv_color_t color, uint8_t width
     line_dsc->color = color;
     line_dsc->width = width;
 }
+
+// Every label style the widgets draw with
+static const struct {
+    const lv_font_t *font;
+    bool foreground;
+    lv_text_align_t align;
+} label_dsc_keys[] = {
+    {WIDGET_FONT_14, true, LV_TEXT_ALIGN_CENTER},
+    {WIDGET_FONT_14, false, LV_TEXT_ALIGN_CENTER},
+    {WIDGET_FONT_14, true, LV_TEXT_ALIGN_RIGHT},
+    {WIDGET_FONT_16, true, LV_TEXT_ALIGN_RIGHT},
+    // Layer name
+    {WIDGET_FONT_18, true, LV_TEXT_ALIGN_LEFT},
+};
+
+// Lines are all drawn in the foreground colour, at these widths
+static const uint8_t line_dsc_widths[] = {2};
+
+static lv_draw_label_dsc_t label_dscs[ARRAY_SIZE(label_dsc_keys)];
+// Background, then foreground
+static lv_draw_rect_dsc_t rect_dscs[2];
+static lv_draw_line_dsc_t line_dscs[ARRAY_SIZE(line_dsc_widths)];
+static bool dscs_ready;
+
+void draw_dsc_init(void) {
+    if (dscs_ready) {
+        return;
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(label_dsc_keys); i++) {
+        lv_color_t color = label_dsc_keys[i].foreground ? LVGL_FOREGROUND : LVGL_BACKGROUND;
+        init_label_dsc(&label_dscs[i], color, label_dsc_keys[i].font, label_dsc_keys[i].align);
+    }
+    init_rect_dsc(&rect_dscs[0], LVGL_BACKGROUND);
+    init_rect_dsc(&rect_dscs[1], LVGL_FOREGROUND);
+    for (size_t i = 0; i < ARRAY_SIZE(line_dsc_widths); i++) {
+        init_line_dsc(&line_dscs[i], LVGL_FOREGROUND, line_dsc_widths[i]);
+    }
+    dscs_ready = true;
+}
+
+const lv_draw_label_dsc_t *get_label_dsc(const lv_font_t *font, lv_color_t color,
+                                         lv_text_align_t align) {
+    for (size_t i = 0; i < ARRAY_SIZE(label_dscs); i++) {
+        const lv_draw_label_dsc_t *dsc = &label_dscs[i];
+        if (dsc->font == font && dsc->color.full == color.full && dsc->align == align) {
+            return dsc;
+        }
+    }
+    __ASSERT(false, "no label descriptor for this font, color and align");
+    return &label_dscs[0];
+}
+
+const lv_draw_rect_dsc_t *get_rect_dsc(lv_color_t bg_color) {
+    for (size_t i = 0; i < ARRAY_SIZE(rect_dscs); i++) {
+        if (rect_dscs[i].bg_color.full == bg_color.full) {
+            return &rect_dscs[i];
+        }
+    }
+    __ASSERT(false, "no rect descriptor for this color");
+    return &rect_dscs[0];
+}
+
+const lv_draw_line_dsc_t *get_line_dsc(lv_color_t color, uint8_t width) {
+    for (size_t i = 0; i < ARRAY_SIZE(line_dscs); i++) {
+        if (line_dscs[i].color.full == color.full && line_dscs[i].width == width) {
+            return &line_dscs[i];
+        }
+    }
+    __ASSERT(false, "no line descriptor for this color and width");
+    return &line_dscs[0];
+}
@@ -7,18 +7,53 @@
 #pragma once
 
 #include <lvgl.h>
+#include <zephyr/sys/util.h>
 #include <zmk/endpoints.h>
+#include <zmk/hid.h>
+
+#include "wpm_history.h"
 
 #define NICEVIEW_PROFILE_COUNT 5
 
 #define CANVAS_SIZE 68
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+// Region canvases hold packed, already rotated pixels: 1 = foreground
+#define CANVAS_COLOR_FORMAT LV_IMG_CF_INDEXED_1BIT
+#define CANVAS_BUF_SIZE LV_CANVAS_BUF_SIZE_INDEXED_1BIT(CANVAS_SIZE, CANVAS_SIZE)
+#else
 #define CANVAS_COLOR_FORMAT LV_IMG_CF_TRUE_COLOR
 #define CANVAS_BUF_SIZE (CANVAS_SIZE * CANVAS_SIZE * sizeof(lv_color_t))
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_FONT_SUBSET)
+// Generated at build time by scripts/gen_font_subset.py
+LV_FONT_DECLARE(nv_font_montserrat_14);
+LV_FONT_DECLARE(nv_font_montserrat_16);
+LV_FONT_DECLARE(nv_font_montserrat_18);
+#define WIDGET_FONT_14 (&nv_font_montserrat_14)
+#define WIDGET_FONT_16 (&nv_font_montserrat_16)
+#define WIDGET_FONT_18 (&nv_font_montserrat_18)
+#else
+#define WIDGET_FONT_14 (&lv_font_montserrat_14)
+#define WIDGET_FONT_16 (&lv_font_montserrat_16)
+#define WIDGET_FONT_18 (&lv_font_montserrat_18)
+#endif
 
 #define LVGL_BACKGROUND lv_color_white()
 #define LVGL_FOREGROUND lv_color_black()
 
+// Screen regions, used as dirty bits in status_state
+#define STATUS_REGION_TOP BIT(0)
+#define STATUS_REGION_MIDDLE BIT(1)
+#define STATUS_REGION_BOTTOM BIT(2)
+#define STATUS_REGION_ALL (STATUS_REGION_TOP | STATUS_REGION_MIDDLE | STATUS_REGION_BOTTOM)
+#define STATUS_REGION_COUNT 3
+
 struct status_state {
+    // Regions whose inputs changed since they were last drawn
+    uint8_t dirty;
+    // Regions whose data sources are set up; the others keep a placeholder
+    uint8_t ready;
     uint8_t battery;
     bool charging;
 #if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
@@ -27,13 +62,19 @@ struct status_state {
     bool active_profile_connected;
     bool active_profile_bonded;
     uint8_t layer_index;
-    const char *layer_label;
-    uint8_t wpm[10];
+    struct wpm_history wpm;
+    zmk_mod_flags_t mods;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_PERIPHERAL_BATTERY)
+    // PERIPHERAL_BATTERY_UNKNOWN until the first level arrives
+    uint8_t peripheral_battery;
+#endif
 #else
     bool connected;
 #endif
 };
 
+#define PERIPHERAL_BATTERY_UNKNOWN UINT8_MAX
+
 struct battery_status_state {
     uint8_t level;
 #if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
@@ -41,8 +82,96 @@ struct battery_status_state {
 #endif
 };
 
-void rotate_canvas(lv_obj_t *canvas, lv_color_t cbuf[]);
+// Where a region's pixels live for the direct framebuffer backend: logical
+// (x, y) is row x of buf, bit column col0 + CANVAS_SIZE - 1 - y (MSB first).
+// Only logical rows y0 .. y1 - 1 are drawn; a region's own canvas has col0 0
+// and all 68 rows, a window of the full-screen canvas a part of them.
+// Defined for every backend: nv_assets.h always includes fb.h.
+struct fb_view {
+    uint8_t *buf;
+    uint16_t stride;
+    int16_t col0;
+    int16_t y0;
+    int16_t y1;
+};
+
+// A 68x68 widget region. By default it is its own canvas holding the
+// region's rotated pixels. With CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS it
+// is a fixed window of the full-screen canvas instead: only logical rows
+// y0 .. y1 - 1 are shown, at screen columns col0 + CANVAS_SIZE - 1 - y.
+struct screen_canvas;
+
+struct region {
+    lv_obj_t *obj;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+    struct screen_canvas *screen;
+    int16_t col0;
+    int16_t y0;
+    int16_t y1;
+#else
+    uint8_t *cbuf;
+#endif
+};
+
+// A region being drawn. By default draws go through LVGL into the shared
+// scratch canvas, which region_draw_end rotates into the region's buffer;
+// with CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB they write the region's
+// packed 1bpp pixels directly.
+struct region_draw {
+    const struct region *region;
+#if IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+    struct fb_view fb;
+#else
+    lv_obj_t *canvas;
+#endif
+};
+
+void init_canvas(lv_obj_t *canvas, uint8_t cbuf[]);
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_DIRECT_FB)
+// The scratch canvas lives in the scratch arena, which has no room for it
+// when drawing goes straight to the framebuffer
+lv_obj_t *scratch_canvas(void);
+void rotate_canvas(lv_obj_t *canvas, uint8_t cbuf[]);
+#endif
+#if IS_ENABLED(CONFIG_LV_COLOR_DEPTH_1)
+// Row stride of a packed 1bpp canvas, MSB first like LVGL's 1-bit formats
+#define CANVAS_STRIDE_1BPP ((CANVAS_SIZE + 7) / 8)
+void rotate_1bpp(const uint8_t *src, uint8_t *dst);
+// Pack a true color CANVAS_SIZE square canvas, 1 = anything but background
+void pack_1bpp(const lv_color_t *cbuf, uint8_t *packed);
+#endif
+
+#if !IS_ENABLED(CONFIG_NICE_VIEW_CUSTOM_WIDGET_SINGLE_CANVAS)
+// Make canvas, backed by cbuf, the region's own canvas
+void region_init_canvas(struct region *region, lv_obj_t *canvas, uint8_t cbuf[]);
+#endif
+
+// Blank region with a "..." marker, shown until its data is ready
+void draw_placeholder(const struct region *region);
+
+void region_draw_begin(struct region_draw *draw, const struct region *region);
+void region_draw_end(struct region_draw *draw);
+void region_fill_rect(const struct region_draw *draw, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                      lv_coord_t h, lv_color_t color);
+void region_draw_text(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                      lv_coord_t max_w, const lv_draw_label_dsc_t *dsc, const char *text);
+void region_draw_line(const struct region_draw *draw, const lv_point_t *points, uint16_t count,
+                      const lv_draw_line_dsc_t *dsc);
+void region_draw_img(const struct region_draw *draw, lv_coord_t x, lv_coord_t y,
+                     const lv_img_dsc_t *img);
+
 void init_label_dsc(lv_draw_label_dsc_t *label_dsc, lv_color_t color, const lv_font_t *font,
                     lv_text_align_t align);
 void init_rect_dsc(lv_draw_rect_dsc_t *rect_dsc, lv_color_t bg_color);
 void init_line_dsc(lv_draw_line_dsc_t *line_dsc, lv_color_t color, uint8_t width);
+
+// Shared draw descriptors looked up by their key. draw_dsc_init fills the
+// tables once, from the fixed set of keys the widgets draw with, before the
+// first frame; lookups only read them, so the display queue and the render
+// thread can share them. An unknown key asserts, or draws with the first
+// entry of its kind when asserts are off.
+void draw_dsc_init(void);
+const lv_draw_label_dsc_t *get_label_dsc(const lv_font_t *font, lv_color_t color,
+                                         lv_text_align_t align);
+const lv_draw_rect_dsc_t *get_rect_dsc(lv_color_t bg_color);
+const lv_draw_line_dsc_t *get_line_dsc(lv_color_t color, uint8_t width);
@@ -0,0 +1,104 @@
+/*
+ * Custom Nice!View scrolling WPM graph
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "scratch.h"
+#include "wpm_graph.h"
+
+#define WPM_GRAPH_LINE_WIDTH 2
+
+void wpm_graph_init(struct wpm_graph *graph, lv_coord_t x, lv_coord_t width, lv_coord_t y_bottom,
+                    lv_coord_t height) {
+    memset(graph, 0, sizeof(*graph));
+    graph->fb = fb_view_region(graph->buf);
+    graph->x = x;
+    graph->width = width;
+    graph->y_bottom = y_bottom;
+    graph->height = height;
+}
+
+static lv_coord_t value_y(const struct wpm_graph *graph, uint8_t value) {
+    int range = MAX(graph->max - graph->min, 1);
+    return graph->y_bottom - (value - graph->min) * graph->height / range;
+}
+
+static void rebuild(struct wpm_graph *graph, const struct wpm_history *history) {
+    memset(graph->buf, 0, sizeof(graph->buf));
+    graph->rebuilds++;
+
+    lv_point_t *points = scratch_alloc(WPM_HISTORY_MAX_POINTS(graph->width) * sizeof(lv_point_t));
+    if (points == NULL) {
+        return;
+    }
+    int count = wpm_history_decimate(history, points, graph->x, graph->width, graph->y_bottom,
+                                     graph->height);
+    if (count > 1) {
+        fb_draw_line(&graph->fb, points, count, WPM_GRAPH_LINE_WIDTH, true);
+    }
+}
+
+// Segment from sample seq - 1 to sample seq, the latter drawn at column x
+static void draw_segment(struct wpm_graph *graph, const struct wpm_history *history, uint32_t seq,
+                         lv_coord_t x, lv_coord_t spacing) {
+    lv_point_t segment[2] = {
+        {x - spacing, value_y(graph, wpm_history_sample(history, seq - 1))},
+        {x, value_y(graph, wpm_history_sample(history, seq))},
+    };
+    fb_draw_line(&graph->fb, segment, ARRAY_SIZE(segment), WPM_GRAPH_LINE_WIDTH, true);
+}
+
+// Rows of the buffer are logical columns, so scrolling left is a row move
+static void shift(struct wpm_graph *graph, lv_coord_t columns) {
+    size_t moved = (CANVAS_SIZE - columns) * FB_STRIDE;
+    memmove(graph->buf, graph->buf + columns * FB_STRIDE, moved);
+    memset(graph->buf + moved, 0, columns * FB_STRIDE);
+}
+
+void wpm_graph_update(struct wpm_graph *graph, const struct wpm_history *history) {
+    uint32_t fresh = history->total - graph->total;
+    if (wpm_graph_drawn(graph) && fresh == 0) {
+        return;
+    }
+
+    // Column layout as in wpm_history_decimate
+    uint32_t step = DIV_ROUND_UP(WPM_HISTORY_LEN, graph->width);
+    uint32_t cols = DIV_ROUND_UP(WPM_HISTORY_LEN, step);
+    lv_coord_t spacing = wpm_history_column_x(1, cols, graph->width);
+    // Shifting by whole columns only works when they are evenly spaced
+    bool even = cols > 1 && (graph->width - 1) % (cols - 1) == 0;
+    uint8_t min = wpm_history_min(history);
+    uint8_t max = wpm_history_max(history);
+
+    bool scroll = wpm_graph_drawn(graph) && step == 1 && even && fresh < cols &&
+                  min == graph->min && max == graph->max;
+    graph->min = min;
+    graph->max = max;
+    if (!scroll) {
+        rebuild(graph, history);
+        graph->total = history->total;
+        return;
+    }
+
+    // Each new segment is drawn on top of what scrolled
+    lv_coord_t newest = graph->x + (cols - 1) * spacing;
+    for (uint32_t seq = graph->total; seq < history->total; seq++) {
+        shift(graph, spacing);
+        draw_segment(graph, history, seq, newest, spacing);
+    }
+
+    // The segment that left the window scrolled into the first column; clear
+    // the columns up to it and redraw the segments that reach them. Drawing
+    // an already drawn segment again changes nothing.
+    uint32_t oldest = history->total - cols;
+    memset(graph->buf, 0, (graph->x + 1) * FB_STRIDE);
+    for (uint32_t i = 1; i <= MIN(2, cols - 1); i++) {
+        draw_segment(graph, history, oldest + i, graph->x + i * spacing, spacing);
+    }
+
+    graph->scrolls += fresh;
+    graph->total = history->total;
+}
@@ -0,0 +1,43 @@
+/*
+ * Custom Nice!View scrolling WPM graph
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <lvgl.h>
+
+#include "fb.h"
+#include "wpm_history.h"
+
+// The WPM graph line kept in its own buffer, laid out like a region's 1bpp
+// pixels so it can be copied into one. A new sample shifts the buffer by one
+// column and draws only the newest segment; the whole line is redrawn when
+// the window's min/max, and so the scale, changes, or when samples cannot
+// scroll one column each (more samples than graph columns).
+struct wpm_graph {
+    uint8_t buf[FB_SIZE];
+    struct fb_view fb;
+    lv_coord_t x;
+    lv_coord_t width;
+    lv_coord_t y_bottom;
+    lv_coord_t height;
+    // History total and value range the buffer was drawn for; total 0
+    // means nothing is drawn yet
+    uint32_t total;
+    uint8_t min;
+    uint8_t max;
+    uint32_t scrolls;
+    uint32_t rebuilds;
+};
+
+// Same plot geometry as wpm_history_decimate
+void wpm_graph_init(struct wpm_graph *graph, lv_coord_t x, lv_coord_t width, lv_coord_t y_bottom,
+                    lv_coord_t height);
+// Bring the buffer up to date with the history
+void wpm_graph_update(struct wpm_graph *graph, const struct wpm_history *history);
+// Force a full redraw on the next update
+static inline void wpm_graph_invalidate(struct wpm_graph *graph) { graph->total = 0; }
+static inline bool wpm_graph_drawn(const struct wpm_graph *graph) { return graph->total != 0; }
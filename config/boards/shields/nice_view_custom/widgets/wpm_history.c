@@ -0,0 +1,135 @@
+/*
+ * Custom Nice!View WPM history
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "wpm_history.h"
+
+static inline uint16_t wedge_front(const struct wpm_wedge *wedge) {
+    return wedge->slot[wedge->first];
+}
+
+static inline uint16_t wedge_back(const struct wpm_wedge *wedge) {
+    return wedge->slot[(wedge->first + wedge->len - 1) % WPM_HISTORY_LEN];
+}
+
+static void wedge_evict(struct wpm_wedge *wedge, uint16_t slot) {
+    if (wedge->len > 0 && wedge_front(wedge) == slot) {
+        wedge->first = (wedge->first + 1) % WPM_HISTORY_LEN;
+        wedge->len--;
+    }
+}
+
+// Drop samples from the back that can no longer be the window's min (or
+// max), then append the new slot
+static void wedge_push(struct wpm_wedge *wedge, const uint8_t *samples, uint16_t slot,
+                       bool is_max) {
+    uint8_t value = samples[slot];
+    while (wedge->len > 0) {
+        uint8_t back = samples[wedge_back(wedge)];
+        if (is_max ? back > value : back < value) {
+            break;
+        }
+        wedge->len--;
+    }
+    wedge->slot[(wedge->first + wedge->len) % WPM_HISTORY_LEN] = slot;
+    wedge->len++;
+}
+
+void wpm_history_init(struct wpm_history *history) {
+    memset(history, 0, sizeof(*history));
+    for (int i = 0; i < WPM_HISTORY_LEN; i++) {
+        wpm_history_push(history, 0);
+    }
+}
+
+void wpm_history_push(struct wpm_history *history, uint8_t wpm) {
+    uint16_t slot = history->head;
+
+    if (history->total >= WPM_HISTORY_LEN) {
+        wedge_evict(&history->min, slot);
+        wedge_evict(&history->max, slot);
+    }
+    history->samples[slot] = wpm;
+    wedge_push(&history->min, history->samples, slot, false);
+    wedge_push(&history->max, history->samples, slot, true);
+
+    history->head = (slot + 1) % WPM_HISTORY_LEN;
+    history->total++;
+}
+
+uint8_t wpm_history_latest(const struct wpm_history *history) {
+    return history->samples[(history->head + WPM_HISTORY_LEN - 1) % WPM_HISTORY_LEN];
+}
+
+uint8_t wpm_history_min(const struct wpm_history *history) {
+    return history->samples[wedge_front(&history->min)];
+}
+
+uint8_t wpm_history_max(const struct wpm_history *history) {
+    return history->samples[wedge_front(&history->max)];
+}
+
+uint8_t wpm_history_sample(const struct wpm_history *history, uint32_t seq) {
+    return history->samples[seq % WPM_HISTORY_LEN];
+}
+
+int wpm_history_decimate(const struct wpm_history *history, lv_point_t *points, lv_coord_t x,
+                         lv_coord_t width, lv_coord_t y_bottom, lv_coord_t height) {
+    uint32_t count = MIN(history->total, WPM_HISTORY_LEN);
+    uint32_t step = DIV_ROUND_UP(WPM_HISTORY_LEN, width);
+    uint32_t cols = DIV_ROUND_UP(WPM_HISTORY_LEN, step);
+
+    int min = wpm_history_min(history);
+    int range = wpm_history_max(history) - min;
+    if (range == 0) {
+        range = 1;
+    }
+
+    // Buckets are step-aligned in absolute sample numbers; the oldest one
+    // may be partial, and is dropped if the window spans cols + 1 buckets
+    uint32_t end = history->total;
+    uint32_t last_bucket = (end - 1) / step;
+    uint32_t first_bucket = (end - count) / step;
+    if (last_bucket - first_bucket >= cols) {
+        first_bucket = last_bucket - cols + 1;
+    }
+
+    int n = 0;
+    for (uint32_t bucket = first_bucket; bucket <= last_bucket; bucket++) {
+        uint32_t from = MAX(bucket * step, end - count);
+        uint32_t to = MIN((bucket + 1) * step, end);
+        uint32_t min_seq = from, max_seq = from;
+        uint8_t lo = UINT8_MAX, hi = 0;
+
+        for (uint32_t seq = from; seq < to; seq++) {
+            uint8_t value = history->samples[seq % WPM_HISTORY_LEN];
+            if (value < lo) {
+                lo = value;
+                min_seq = seq;
+            }
+            if (value > hi) {
+                hi = value;
+                max_seq = seq;
+            }
+        }
+
+        lv_coord_t px = x + wpm_history_column_x(bucket - first_bucket, cols, width);
+        uint8_t first = min_seq <= max_seq ? lo : hi;
+        uint8_t second = min_seq <= max_seq ? hi : lo;
+
+        points[n].x = px;
+        points[n].y = y_bottom - (first - min) * height / range;
+        n++;
+        if (second != first) {
+            points[n].x = px;
+            points[n].y = y_bottom - (second - min) * height / range;
+            n++;
+        }
+    }
+
+    return n;
+}
@@ -0,0 +1,58 @@
+/*
+ * Custom Nice!View WPM history
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#define WPM_HISTORY_LEN CONFIG_NICE_VIEW_CUSTOM_WIDGET_WPM_HISTORY
+
+// Monotonic queue of ring slots, used to keep the window min/max current
+struct wpm_wedge {
+    uint16_t slot[WPM_HISTORY_LEN];
+    uint16_t first;
+    uint16_t len;
+};
+
+// Ring buffer of the last WPM_HISTORY_LEN samples with O(1) amortized
+// min/max tracking
+struct wpm_history {
+    uint8_t samples[WPM_HISTORY_LEN];
+    uint16_t head;
+    // Samples pushed since init; decimation buckets are aligned to it so
+    // columns stay put as the window scrolls
+    uint32_t total;
+    struct wpm_wedge min;
+    struct wpm_wedge max;
+};
+
+// Start with a full window of zero samples, like an idle keyboard
+void wpm_history_init(struct wpm_history *history);
+void wpm_history_push(struct wpm_history *history, uint8_t wpm);
+
+uint8_t wpm_history_latest(const struct wpm_history *history);
+uint8_t wpm_history_min(const struct wpm_history *history);
+uint8_t wpm_history_max(const struct wpm_history *history);
+// Sample number seq, counted from init like total; it must still be in the window
+uint8_t wpm_history_sample(const struct wpm_history *history, uint32_t seq);
+
+// Max number of points wpm_history_decimate can emit for a graph width
+#define WPM_HISTORY_MAX_POINTS(width) (2 * MIN(WPM_HISTORY_LEN, (width)))
+
+// Offset from the graph's x of column i when cols columns span width pixels.
+// Columns are spread over the whole width, so spacing is uneven unless
+// cols - 1 divides width - 1.
+static inline lv_coord_t wpm_history_column_x(uint32_t i, uint32_t cols, lv_coord_t width) {
+    return cols > 1 ? (lv_coord_t)(i * (width - 1) / (cols - 1)) : 0;
+}
+
+// Reduce the window to at most `width` columns spanning x .. x + width - 1,
+// keeping each column's min and max in the order they occurred. The value
+// range maps to y_bottom .. y_bottom - height. Returns the number of points
+// written.
+int wpm_history_decimate(const struct wpm_history *history, lv_point_t *points, lv_coord_t x,
+                         lv_coord_t width, lv_coord_t y_bottom, lv_coord_t height);